@@ -4,20 +4,184 @@
 
 #include "Containers/Array.h"
 #include "Algo/Reverse.h"
-#include "Containers/Array.h"
-#include <limits>
+#include "Async/ParallelFor.h"
+
+namespace PCGPathfindLocals
+{
+    /**
+     * Uniform grid over the graph nodes. Nodes are stored sorted by cell so that every cell is a
+     * contiguous slice of SortedNodeIndices, which keeps the structure to three flat allocations.
+     */
+    struct FNodeGrid
+    {
+        void Build(const TArray<FVector>& Positions, double InCellSize)
+        {
+            Origin = Positions[0];
+            FVector MaxPosition = Origin;
+            for (const FVector& Position : Positions)
+            {
+                Origin = Origin.ComponentMin(Position);
+                MaxPosition = MaxPosition.ComponentMax(Position);
+            }
+
+            // Keep the cell coordinates well inside int32 range even for degenerate spacings
+            const double MinCellSize = FMath::Max((MaxPosition - Origin).GetMax() / 1000000.0, UE_KINDA_SMALL_NUMBER);
+            InvCellSize = 1.0 / FMath::Max(InCellSize, MinCellSize);
+
+            TArray<int32> NodeBuckets;
+            NodeBuckets.SetNumUninitialized(Positions.Num());
+            TArray<int32> BucketCounts;
+            CellToBucket.Reset();
+
+            for (int32 i = 0; i < Positions.Num(); ++i)
+            {
+                const FIntVector Cell = GetCell(Positions[i]);
+                int32* Bucket = CellToBucket.Find(Cell);
+                if (!Bucket)
+                {
+                    Bucket = &CellToBucket.Add(Cell, BucketCounts.Add(0));
+                }
+                NodeBuckets[i] = *Bucket;
+                ++BucketCounts[*Bucket];
+            }
+
+            BucketStarts.SetNumUninitialized(BucketCounts.Num() + 1);
+            BucketStarts[0] = 0;
+            for (int32 b = 0; b < BucketCounts.Num(); ++b)
+            {
+                BucketStarts[b + 1] = BucketStarts[b] + BucketCounts[b];
+                BucketCounts[b] = BucketStarts[b];
+            }
+
+            SortedNodeIndices.SetNumUninitialized(Positions.Num());
+            for (int32 i = 0; i < Positions.Num(); ++i)
+            {
+                SortedNodeIndices[BucketCounts[NodeBuckets[i]]++] = i;
+            }
+        }
 
-#include "ToolSet/Algorithms/AStarPathFinding/PriorityQueue.h"
+        /** Calls Callback with every node index stored in the cell containing Position and its 26 neighbors */
+        template<typename CallbackType>
+        void ForEachNodeNear(const FVector& Position, CallbackType&& Callback) const
+        {
+            const FIntVector Center = GetCell(Position);
+            for (int32 dz = -1; dz <= 1; ++dz)
+            {
+                for (int32 dy = -1; dy <= 1; ++dy)
+                {
+                    for (int32 dx = -1; dx <= 1; ++dx)
+                    {
+                        const int32* Bucket = CellToBucket.Find(Center + FIntVector(dx, dy, dz));
+                        if (!Bucket)
+                        {
+                            continue;
+                        }
+
+                        for (int32 k = BucketStarts[*Bucket]; k < BucketStarts[*Bucket + 1]; ++k)
+                        {
+                            Callback(SortedNodeIndices[k]);
+                        }
+                    }
+                }
+            }
+        }
+
+    private:
+        FIntVector GetCell(const FVector& Position) const
+        {
+            return FIntVector(
+                FMath::FloorToInt32((Position.X - Origin.X) * InvCellSize),
+                FMath::FloorToInt32((Position.Y - Origin.Y) * InvCellSize),
+                FMath::FloorToInt32((Position.Z - Origin.Z) * InvCellSize));
+        }
+
+        FVector Origin = FVector::ZeroVector;
+        double InvCellSize = 1.0;
+        TMap<FIntVector, int32> CellToBucket;
+        TArray<int32> BucketStarts;
+        TArray<int32> SortedNodeIndices;
+    };
+
+    /**
+     * A* from StartIndex to EndIndex that never leaves the nodes accepted by Filter.
+     * With an invalid EndIndex the search degrades to Dijkstra and settles every reachable node.
+     */
+    template<typename FilterType>
+    bool RunFilteredSearch(const FPathfindGraph& Graph, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState, FilterType&& Filter)
+    {
+        SearchState.Reset(Graph.Num());
+
+        const bool bHasGoal = Graph.IsValidIndex(EndIndex);
+        const FVector Goal = bHasGoal ? Graph.Positions[EndIndex] : FVector::ZeroVector;
+
+        SearchState.SetCost(StartIndex, 0.f, INDEX_NONE);
+        SearchState.Frontier.EnqueueOrDecrease(StartIndex, bHasGoal ? UPCGPathfindHelper::Heuristic(Graph.Positions[StartIndex], Goal) : 0.f);
+
+        const bool bHasEdgeCosts = Graph.EdgeCosts.Num() == Graph.AdjacencyIndices.Num();
+        while (!SearchState.Frontier.IsEmpty())
+        {
+            const int32 Current = SearchState.Frontier.Dequeue();
+            if (Current == EndIndex)
+            {
+                return true;
+            }
 
-float UPCGPathfindHelper::Heuristic(const FGraphNode& Node, const FGraphNode& Goal)
+            // The straight-line heuristic never overestimates Cost, so a settled node is final
+            SearchState.Closed[Current] = true;
+
+            const FVector& CurrentPosition = Graph.Positions[Current];
+            const float CurrentCost = SearchState.CostSoFar[Current];
+
+            for (int32 Edge = Graph.AdjacencyOffsets[Current]; Edge < Graph.AdjacencyOffsets[Current + 1]; ++Edge)
+            {
+                const int32 Next = Graph.AdjacencyIndices[Edge];
+                if (SearchState.Closed[Next] || !Filter(Next))
+                {
+                    continue;
+                }
+
+                const float EdgeCost = bHasEdgeCosts ? Graph.EdgeCosts[Edge] : UPCGPathfindHelper::Cost(CurrentPosition, Graph.Positions[Next]);
+                if (EdgeCost >= UPCGPathfindHelper::BlockedCost)
+                {
+                    continue;
+                }
+
+                const float NewCost = CurrentCost + EdgeCost;
+                if (NewCost < SearchState.CostSoFar[Next])
+                {
+                    SearchState.SetCost(Next, NewCost, Current);
+                    SearchState.Frontier.EnqueueOrDecrease(Next, bHasGoal ? NewCost + UPCGPathfindHelper::Heuristic(Graph.Positions[Next], Goal) : NewCost);
+                }
+            }
+        }
+
+        return !bHasGoal;
+    }
+
+    TArray<int32> ExtractPath(const FPathfindSearchState& SearchState, int32 EndIndex)
+    {
+        TArray<int32> PathIndices;
+        for (int32 Current = EndIndex; Current != INDEX_NONE; Current = SearchState.Parents[Current])
+        {
+            PathIndices.Add(Current);
+        }
+
+        // Reverse the order of nodes
+        Algo::Reverse(PathIndices);
+
+        return PathIndices;
+    }
+}
+
+float UPCGPathfindHelper::Heuristic(const FVector& Node, const FVector& Goal)
 {
-    return Node.Position.GetEuclideanDistance(Goal.Position);
+    return FVector::Dist(Node, Goal);
 }
 
-float UPCGPathfindHelper::Cost(const FGraphNode& Node1, const FGraphNode& Node2)
+float UPCGPathfindHelper::Cost(const FVector& Node1, const FVector& Node2)
 {
-    float DistanceXY = FVector2D(Node1.Position.X - Node2.Position.X, Node1.Position.Y - Node2.Position.Y).Size();
-    float DistanceZ = FMath::Abs(Node1.Position.Z - Node2.Position.Z);
+    float DistanceXY = FVector2D(Node1.X - Node2.X, Node1.Y - Node2.Y).Size();
+    float DistanceZ = FMath::Abs(Node1.Z - Node2.Z);
 
     // Define a threshold for the maximum allowed Z difference for walking on slopes
     float MaxAllowedZDifference = 100.0f;
@@ -29,218 +193,735 @@ float UPCGPathfindHelper::Cost(const FGraphNode& Node1, const FGraphNode& Node2)
     if (DistanceZ > MaxAllowedZDifference)
     {
         // Assign a very high cost to discourage walking on steep slopes
-        return 999999.0f;
+        return BlockedCost;
     }
 
     return DistanceXY + ZFactor * DistanceZ;
 }
 
-TArray<FGraphNode> UPCGPathfindHelper::GetNeighbors(FGraphNode CurrentNode, TArray<FGraphNode> PathPoints)
+float UPCGPathfindHelper::GetConnectionDistance(const TArray<FVector>& Positions)
 {
-    TArray<FGraphNode> Neighbors;
+    const int32 NumNodes = Positions.Num();
+    if (NumNodes < 2)
+    {
+        return 0.f;
+    }
+
+    FVector MinPosition = Positions[0];
+    FVector MaxPosition = Positions[0];
+    for (const FVector& Position : Positions)
+    {
+        MinPosition = MinPosition.ComponentMin(Position);
+        MaxPosition = MaxPosition.ComponentMax(Position);
+    }
+    const FVector Dimensions = MaxPosition - MinPosition;
+    const double MaxDimension = Dimensions.GetMax();
+    if (MaxDimension <= CustomPointEpsilon)
+    {
+        return 0.f;
+    }
 
-    // Assuming ConnectedNodeIndices is an array of indices
-    for (int Index : CurrentNode.ConnectedNodeIndices)
+    // First guess at the spacing: N points spread evenly over the extent of the axes that are not flat
+    double Extent = 1.0;
+    int32 NumAxes = 0;
+    for (int32 Axis = 0; Axis < 3; ++Axis)
+    {
+        if (Dimensions[Axis] > CustomPointEpsilon)
+        {
+            Extent *= Dimensions[Axis];
+            ++NumAxes;
+        }
+    }
+    double CellSize = FMath::Pow(Extent / NumNodes, 1.0 / NumAxes);
+
+    // The spacing is the median nearest neighbor distance. A neighbor within one cell is always in the 27 cells
+    // around a node, so nodes without one are only known to be further apart. As long as those are at most half
+    // of the nodes the median is still among the found ones, otherwise the cells are grown and searched again.
+    TArray<double> NearestDistances;
+    NearestDistances.SetNumUninitialized(NumNodes);
+    const int32 MedianIndex = (NumNodes - 1) / 2;
+    for (;;)
     {
-        // Check if the index is valid
-        if (Index >= 0 && Index < PathPoints.Num())
+        PCGPathfindLocals::FNodeGrid Grid;
+        Grid.Build(Positions, CellSize);
+
+        const double CellSizeSq = FMath::Square(CellSize);
+        ParallelFor(NumNodes, [&Positions, &Grid, &NearestDistances, CellSizeSq](int32 i)
+        {
+            const FVector& Position = Positions[i];
+            double NearestSq = TNumericLimits<double>::Max();
+            Grid.ForEachNodeNear(Position, [&](int32 j)
+            {
+                const double DistanceSq = FVector::DistSquared(Position, Positions[j]);
+                if (j != i && !Position.Equals(Positions[j], CustomPointEpsilon) && DistanceSq <= CellSizeSq)
+                {
+                    NearestSq = FMath::Min(NearestSq, DistanceSq);
+                }
+            });
+            NearestDistances[i] = NearestSq;
+        });
+
+        NearestDistances.Sort();
+        if (NearestDistances[MedianIndex] < TNumericLimits<double>::Max())
+        {
+            break;
+        }
+        if (CellSize > 2.0 * MaxDimension)
         {
-            Neighbors.Add(PathPoints[Index]);
+            // Only duplicates, nothing to connect
+            return 0.f;
         }
+        CellSize *= 2.0;
     }
 
-    return Neighbors;
+    // Reach the diagonal neighbors as well, with some slack so they are not lost to rounding
+    constexpr double RelativeTolerance = 0.01;
+    return static_cast<float>(FMath::Sqrt(NearestDistances[MedianIndex]) * UE_DOUBLE_SQRT_2 * (1.0 + RelativeTolerance));
 }
 
+void UPCGPathfindHelper::InitializeNodes(const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph)
+{
+    OutGraph.Reset();
 
+    const int32 NumNodes = PathPoints.Num();
+    OutGraph.Positions.SetNumUninitialized(NumNodes);
+    OutGraph.Seeds.SetNumUninitialized(NumNodes);
+    for (int32 i = 0; i < NumNodes; ++i)
+    {
+        OutGraph.Positions[i] = PathPoints[i].Transform.GetLocation();
+        OutGraph.Seeds[i] = PathPoints[i].Seed;
+    }
+
+    OutGraph.ConnectionDistance = NumNodes > 0 ? GetConnectionDistance(OutGraph.Positions) : 0.f;
+}
 
-void UPCGPathfindHelper::SetupNodeConnections(TArray<FGraphNode>& Nodes, FGraphNode& StartNode, FGraphNode& EndNode) 
+void UPCGPathfindHelper::BuildAdjacency(FPathfindGraph& Graph, const FPathfindGraph* PreviousGraph, const TBitArray<>* DirtyNodes)
 {
-    if (Nodes.Num() == 0)
+    const int32 NumNodes = Graph.Num();
+    Graph.AdjacencyOffsets.Init(0, NumNodes + 1);
+    Graph.AdjacencyIndices.Reset();
+    Graph.EdgeCosts.Reset();
+    if (NumNodes == 0)
     {
         return;
     }
 
-    FVector MinPosition = Nodes[0].Position;
-    FVector MaxPosition = Nodes[0].Position;
+    const double ConnectionDistanceSq = FMath::Square(static_cast<double>(Graph.ConnectionDistance));
+
+    // Bucket every node into a uniform grid with one connection radius per cell, so each node
+    // only has to test the 27 cells around it instead of the whole array.
+    PCGPathfindLocals::FNodeGrid Grid;
+    Grid.Build(Graph.Positions, Graph.ConnectionDistance);
+
+    // Every node only writes its own connection list, and the radius test is symmetric,
+    // so both directions of an edge get recorded without any locking.
+    TArray<TArray<int32>> Connections;
+    Connections.SetNum(NumNodes);
+    const TArray<FVector>& Positions = Graph.Positions;
+
+    ParallelFor(NumNodes, [&Positions, &Grid, &Connections, PreviousGraph, DirtyNodes, ConnectionDistanceSq](int32 i)
+    {
+        TArray<int32>& NodeConnections = Connections[i];
+
+        // Clean nodes keep the neighbors they had in the previous graph
+        if (PreviousGraph && DirtyNodes && !(*DirtyNodes)[i])
+        {
+            NodeConnections.Append(PreviousGraph->GetNeighbors(i));
+            return;
+        }
+
+        const FVector& Position = Positions[i];
+        Grid.ForEachNodeNear(Position, [&](int32 j)
+        {
+            if (j != i && !Position.Equals(Positions[j], CustomPointEpsilon) &&
+                FVector::DistSquared(Position, Positions[j]) <= ConnectionDistanceSq)
+            {
+                NodeConnections.Add(j);
+            }
+        });
+
+        // Keep the neighbor order stable (ascending) regardless of bucket layout
+        NodeConnections.Sort();
+    });
 
-    // Find the minimum and maximum positions
-    for (const FGraphNode& gnode : Nodes)
+    // Flatten into CSR
+    for (int32 i = 0; i < NumNodes; ++i)
     {
-        MinPosition = MinPosition.ComponentMin(gnode.Position);
-        MaxPosition = MaxPosition.ComponentMax(gnode.Position);
+        Graph.AdjacencyOffsets[i + 1] = Graph.AdjacencyOffsets[i] + Connections[i].Num();
     }
 
-    // Calculate the dimensions
-    FVector Dimensions = MaxPosition - MinPosition;
+    Graph.AdjacencyIndices.SetNumUninitialized(Graph.AdjacencyOffsets[NumNodes]);
+    Graph.EdgeCosts.SetNumUninitialized(Graph.AdjacencyOffsets[NumNodes]);
+    ParallelFor(NumNodes, [&Graph, &Connections](int32 i)
+    {
+        const int32 Begin = Graph.AdjacencyOffsets[i];
+        for (int32 k = 0; k < Connections[i].Num(); ++k)
+        {
+            const int32 Neighbor = Connections[i][k];
+            Graph.AdjacencyIndices[Begin + k] = Neighbor;
+            Graph.EdgeCosts[Begin + k] = Cost(Graph.Positions[i], Graph.Positions[Neighbor]);
+        }
+    });
+}
 
-    // Assuming uniform grid, calculate the number of nodes in each dimension
-    int32 NodeCountX = 1, NodeCountY = 1, NodeCountZ = 1;
-    for (const FGraphNode& Node : Nodes)
+void UPCGPathfindHelper::BuildGraph(const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::BuildGraph);
+
+    InitializeNodes(PathPoints, OutGraph);
+    BuildAdjacency(OutGraph, nullptr, nullptr);
+}
+
+bool UPCGPathfindHelper::UpdateGraph(const FPathfindGraph& PreviousGraph, const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::UpdateGraph);
+
+    InitializeNodes(PathPoints, OutGraph);
+
+    // Node indices are only comparable when the point set kept its layout and spacing
+    const int32 NumNodes = OutGraph.Num();
+    if (NumNodes != PreviousGraph.Num() || NumNodes == 0 ||
+        PreviousGraph.AdjacencyOffsets.Num() != NumNodes + 1 ||
+        !FMath::IsNearlyEqual(OutGraph.ConnectionDistance, PreviousGraph.ConnectionDistance, CustomPointEpsilon))
     {
-        if (FMath::IsNearlyEqual(Node.Position.X, MinPosition.X))
-            NodeCountY *= (FMath::IsNearlyEqual(Node.Position.Y, MinPosition.Y) ? NodeCountZ++ : NodeCountZ);
-        else if (FMath::IsNearlyEqual(Node.Position.Y, MinPosition.Y))
-            NodeCountX++;
+        BuildAdjacency(OutGraph, nullptr, nullptr);
+        return false;
     }
 
-    // Calculate the distances between nodes in each dimension
-    float DistanceX = Dimensions.X / (NodeCountX - 1);
-    float DistanceY = Dimensions.Y / (NodeCountY - 1);
-    float DistanceZ = NodeCountZ > 1 ? Dimensions.Z / (NodeCountZ - 1) : FLT_MAX;
+    TArray<int32> MovedNodes;
+    for (int32 i = 0; i < NumNodes; ++i)
+    {
+        if (!OutGraph.Positions[i].Equals(PreviousGraph.Positions[i], CustomPointEpsilon))
+        {
+            MovedNodes.Add(i);
+        }
+    }
 
-    // Calculate the maximum connection distance (considering diagonally adjacent nodes)
-    float ConnectionDistance = FMath::Sqrt(FMath::Pow(DistanceX, 2) + FMath::Pow(DistanceY, 2) + FMath::Pow(DistanceZ, 2));
+    if (MovedNodes.IsEmpty())
+    {
+        OutGraph.AdjacencyOffsets = PreviousGraph.AdjacencyOffsets;
+        OutGraph.AdjacencyIndices = PreviousGraph.AdjacencyIndices;
+        OutGraph.EdgeCosts = PreviousGraph.EdgeCosts;
+        return true;
+    }
 
-    // Now setup the connections using the calculated connection distance
-    for (int i = 0; i < Nodes.Num(); ++i)
+    // Past a quarter of the graph, diffing costs more than it saves
+    if (MovedNodes.Num() * 4 > NumNodes)
     {
-        for (int j = i + 1; j < Nodes.Num(); ++j)
+        BuildAdjacency(OutGraph, nullptr, nullptr);
+        return false;
+    }
+
+    // A node's neighbors can only change if a moved node was, or now is, within connection range of it.
+    // Everything around the old and new position of every moved node is relinked, the rest is copied.
+    PCGPathfindLocals::FNodeGrid PreviousGrid;
+    PreviousGrid.Build(PreviousGraph.Positions, PreviousGraph.ConnectionDistance);
+    PCGPathfindLocals::FNodeGrid Grid;
+    Grid.Build(OutGraph.Positions, OutGraph.ConnectionDistance);
+
+    const double ConnectionDistanceSq = FMath::Square(static_cast<double>(OutGraph.ConnectionDistance));
+    TBitArray<> DirtyNodes(false, NumNodes);
+    for (const int32 MovedIndex : MovedNodes)
+    {
+        DirtyNodes[MovedIndex] = true;
+
+        const FVector& OldPosition = PreviousGraph.Positions[MovedIndex];
+        PreviousGrid.ForEachNodeNear(OldPosition, [&](int32 j)
         {
-            // Check if the nodes are within the connection distance and not the same node
-            if (Nodes[i].Position != Nodes[j].Position &&
-                FVector::Dist(Nodes[i].Position, Nodes[j].Position) <= ConnectionDistance)
+            if (FVector::DistSquared(OldPosition, PreviousGraph.Positions[j]) <= ConnectionDistanceSq)
             {
-                // If they are, add each node to the other's list of connections
-                Nodes[i].ConnectedNodeIndices.Add(j);
-                Nodes[j].ConnectedNodeIndices.Add(i);
+                DirtyNodes[j] = true;
             }
-        }
+        });
+
+        const FVector& NewPosition = OutGraph.Positions[MovedIndex];
+        Grid.ForEachNodeNear(NewPosition, [&](int32 j)
+        {
+            if (FVector::DistSquared(NewPosition, OutGraph.Positions[j]) <= ConnectionDistanceSq)
+            {
+                DirtyNodes[j] = true;
+            }
+        });
     }
 
-    // Add connections for StartNode and EndNode
-    for (int i = 0; i < Nodes.Num(); ++i)
+    BuildAdjacency(OutGraph, &PreviousGraph, &DirtyNodes);
+    return true;
+}
+
+int32 UPCGPathfindHelper::FindNodeIndex(const FPathfindGraph& Graph, const FPCGPoint& Point)
+{
+    const int32 SeedIndex = Graph.Seeds.IndexOfByKey(Point.Seed);
+    if (Graph.IsValidIndex(SeedIndex))
     {
-        if (FVector::Dist(StartNode.Position, Nodes[i].Position) <= ConnectionDistance)
-        {
-            StartNode.ConnectedNodeIndices.Add(i);
-            Nodes[i].ConnectedNodeIndices.Add(Nodes.IndexOfByKey(StartNode));
-        }
+        return SeedIndex;
+    }
 
-        if (FVector::Dist(EndNode.Position, Nodes[i].Position) <= ConnectionDistance)
+    const FVector Location = Point.Transform.GetLocation();
+    int32 NearestIndex = INDEX_NONE;
+    double NearestDistanceSq = TNumericLimits<double>::Max();
+    for (int32 i = 0; i < Graph.Num(); ++i)
+    {
+        const double DistanceSq = FVector::DistSquared(Location, Graph.Positions[i]);
+        if (DistanceSq < NearestDistanceSq)
         {
-            EndNode.ConnectedNodeIndices.Add(i);
-            Nodes[i].ConnectedNodeIndices.Add(Nodes.IndexOfByKey(EndNode));
+            NearestDistanceSq = DistanceSq;
+            NearestIndex = i;
         }
     }
 
+    return NearestIndex;
+}
+
+bool UPCGPathfindHelper::RunSearch(const FPathfindGraph& Graph, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState)
+{
+    return PCGPathfindLocals::RunFilteredSearch(Graph, StartIndex, EndIndex, SearchState, [](int32) { return true; });
+}
+
+TArray<int32> UPCGPathfindHelper::FindPathIndices(const FPathfindGraph& Graph, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::FindPathIndices);
+
+    TArray<int32> PathIndices;
+    if (!Graph.IsValidIndex(StartIndex) || !Graph.IsValidIndex(EndIndex))
+    {
+        return PathIndices;
+    }
 
-    // Output some debug info to ensure connections are set up correctly
-    for (int i = 0; i < Nodes.Num(); ++i)
+    if (!RunSearch(Graph, StartIndex, EndIndex, SearchState))
     {
-        FString Neighbors;
-        for (int Index : Nodes[i].ConnectedNodeIndices)
+        return PathIndices;
+    }
+
+    return PCGPathfindLocals::ExtractPath(SearchState, EndIndex);
+}
+
+void UPCGPathfindHelper::BuildCostField(const FPathfindGraph& Graph, int32 GoalIndex, FPathfindSearchState& SearchState)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::BuildCostField);
+
+    check(Graph.IsValidIndex(GoalIndex));
+    RunSearch(Graph, GoalIndex, INDEX_NONE, SearchState);
+}
+
+TArray<int32> UPCGPathfindHelper::ExtractPathFromCostField(const FPathfindSearchState& CostField, int32 StartIndex)
+{
+    TArray<int32> PathIndices;
+    if (!CostField.CostSoFar.IsValidIndex(StartIndex) || CostField.CostSoFar[StartIndex] == MAX_FLT)
+    {
+        return PathIndices;
+    }
+
+    // Cost is symmetric, so walking the field's parents from the start leads down to the goal in order
+    for (int32 Current = StartIndex; Current != INDEX_NONE; Current = CostField.Parents[Current])
+    {
+        PathIndices.Add(Current);
+    }
+
+    return PathIndices;
+}
+
+void UPCGPathfindHelper::FindPathsBatched(const FPathfindGraph& Graph, TConstArrayView<FIntPoint> NodePairs, bool bUseSharedCostField, TArray<TArray<int32>>& OutPaths, const FPathfindHierarchy* Hierarchy)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::FindPathsBatched);
+
+    OutPaths.Reset();
+    OutPaths.SetNum(NodePairs.Num());
+
+    // One job per goal when pairs may share a cost field, otherwise one job per pair
+    struct FQueryJob
+    {
+        int32 GoalIndex = INDEX_NONE;
+        TArray<int32, TInlineAllocator<1>> PairIndices;
+    };
+
+    TArray<FQueryJob> Jobs;
+    TMap<int32, int32> GoalToJob;
+    for (int32 PairIndex = 0; PairIndex < NodePairs.Num(); ++PairIndex)
+    {
+        const FIntPoint& Pair = NodePairs[PairIndex];
+        if (!Graph.IsValidIndex(Pair.X) || !Graph.IsValidIndex(Pair.Y))
+        {
+            continue;
+        }
+
+        if (bUseSharedCostField && !Hierarchy)
         {
-            if (Index >= 0 && Index < Nodes.Num())
+            if (const int32* JobIndex = GoalToJob.Find(Pair.Y))
             {
-                Neighbors += FString::Printf(TEXT("(%f, %f, %f) "), Nodes[Index].Position.X, Nodes[Index].Position.Y, Nodes[Index].Position.Z);
+                Jobs[*JobIndex].PairIndices.Add(PairIndex);
+                continue;
             }
+            GoalToJob.Add(Pair.Y, Jobs.Num());
         }
-        UE_LOG(LogTemp, Warning, TEXT("Node at position (%f, %f, %f) is connected to: %s"), Nodes[i].Position.X, Nodes[i].Position.Y, Nodes[i].Position.Z, *Neighbors);
+
+        FQueryJob& Job = Jobs.AddDefaulted_GetRef();
+        Job.GoalIndex = Pair.Y;
+        Job.PairIndices.Add(PairIndex);
     }
-}
 
+    // Every worker keeps its own search state so the node-sized buffers are allocated once per thread, not per query
+    TArray<FPathfindSearchState> SearchStates;
+    ParallelForWithTaskContext(SearchStates, Jobs.Num(), [&Graph, &NodePairs, &Jobs, &OutPaths, Hierarchy](FPathfindSearchState& SearchState, int32 JobIndex)
+    {
+        const FQueryJob& Job = Jobs[JobIndex];
 
-// FINAL DESTINATION
-TArray<FPCGPoint> UPCGPathfindHelper::FindPath(FPCGPoint StartPoint, FPCGPoint EndPoint, TArray<FPCGPoint> PathPoints)
+        if (Hierarchy)
+        {
+            const int32 PairIndex = Job.PairIndices[0];
+            OutPaths[PairIndex] = FindPathHierarchical(Graph, *Hierarchy, NodePairs[PairIndex].X, Job.GoalIndex, SearchState);
+            return;
+        }
+
+        // A single query is cheaper with the heuristic than flooding the whole graph
+        if (Job.PairIndices.Num() == 1)
+        {
+            const int32 PairIndex = Job.PairIndices[0];
+            OutPaths[PairIndex] = FindPathIndices(Graph, NodePairs[PairIndex].X, Job.GoalIndex, SearchState);
+            return;
+        }
+
+        BuildCostField(Graph, Job.GoalIndex, SearchState);
+        for (const int32 PairIndex : Job.PairIndices)
+        {
+            OutPaths[PairIndex] = ExtractPathFromCostField(SearchState, NodePairs[PairIndex].X);
+        }
+    });
+}
+
+void UPCGPathfindHelper::BuildHierarchy(const FPathfindGraph& Graph, float ClusterSize, int32 PortalsPerBoundary, FPathfindHierarchy& OutHierarchy)
 {
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::BuildHierarchy);
 
-    // Create nodes for the start and end points
-    FGraphNode StartNode = { StartPoint.Transform.GetLocation(), {} };
-    FGraphNode EndNode = { EndPoint.Transform.GetLocation(), {} };
+    OutHierarchy.Reset();
 
-    // Create a graph from path points
-    TArray<FGraphNode> GraphNodes;
-    for (FPCGPoint Point : PathPoints)
+    const int32 NumNodes = Graph.Num();
+    if (NumNodes == 0)
     {
-        FGraphNode Node = { Point.Transform.GetLocation(), {} };
-        if (Point.Seed == StartPoint.Seed) {
-            StartNode = Node;
+        OutHierarchy.ClusterPortalOffsets.Add(0);
+        return;
+    }
+
+    // Roughly 16x16 graph cells per cluster unless told otherwise
+    OutHierarchy.ClusterSize = ClusterSize > 0.f ? ClusterSize : FMath::Max(Graph.ConnectionDistance, UE_KINDA_SMALL_NUMBER) * 16.f;
+    PortalsPerBoundary = FMath::Max(PortalsPerBoundary, 1);
+
+    // Assign every node to a square XY cluster
+    const double InvClusterSize = 1.0 / OutHierarchy.ClusterSize;
+    TMap<FIntPoint, int32> CellToCluster;
+    OutHierarchy.NodeClusters.SetNumUninitialized(NumNodes);
+    for (int32 i = 0; i < NumNodes; ++i)
+    {
+        const FIntPoint Cell(
+            FMath::FloorToInt32(Graph.Positions[i].X * InvClusterSize),
+            FMath::FloorToInt32(Graph.Positions[i].Y * InvClusterSize));
+
+        int32* Cluster = CellToCluster.Find(Cell);
+        if (!Cluster)
+        {
+            Cluster = &CellToCluster.Add(Cell, OutHierarchy.NumClusters++);
         }
-        else if (Point.Seed == EndPoint.Seed) {
-            EndNode = Node;
+        OutHierarchy.NodeClusters[i] = *Cluster;
+    }
+
+    // Gather the walkable edges crossing between every pair of clusters
+    struct FBoundaryEdge
+    {
+        int32 From;
+        int32 To;
+        float Cost;
+    };
+
+    TMap<FIntPoint, TArray<FBoundaryEdge>> Boundaries;
+    const bool bHasEdgeCosts = Graph.EdgeCosts.Num() == Graph.AdjacencyIndices.Num();
+    for (int32 From = 0; From < NumNodes; ++From)
+    {
+        const int32 FromCluster = OutHierarchy.NodeClusters[From];
+        for (int32 Edge = Graph.AdjacencyOffsets[From]; Edge < Graph.AdjacencyOffsets[From + 1]; ++Edge)
+        {
+            const int32 To = Graph.AdjacencyIndices[Edge];
+            const int32 ToCluster = OutHierarchy.NodeClusters[To];
+            if (To < From || ToCluster == FromCluster)
+            {
+                continue;
+            }
+
+            const float EdgeCost = bHasEdgeCosts ? Graph.EdgeCosts[Edge] : Cost(Graph.Positions[From], Graph.Positions[To]);
+            if (EdgeCost >= BlockedCost)
+            {
+                continue;
+            }
+
+            const FIntPoint Key(FMath::Min(FromCluster, ToCluster), FMath::Max(FromCluster, ToCluster));
+            Boundaries.FindOrAdd(Key).Add({ From, To, EdgeCost });
         }
-        GraphNodes.Add(Node);
     }
 
-    SetupNodeConnections(GraphNodes, StartNode, EndNode);
+    // Keep a few evenly spread edges of every boundary as portals
+    OutHierarchy.NodePortals.Init(INDEX_NONE, NumNodes);
+    TArray<TArray<TPair<int32, float>>> AbstractEdges;
 
-    // Constants for handling negative costs
-    const float CostOffset = 100000.0f;
+    auto GetOrAddPortal = [&OutHierarchy, &AbstractEdges](int32 Node)
+    {
+        int32& Portal = OutHierarchy.NodePortals[Node];
+        if (Portal == INDEX_NONE)
+        {
+            Portal = OutHierarchy.PortalNodes.Add(Node);
+            AbstractEdges.AddDefaulted();
+        }
+        return Portal;
+    };
+
+    for (TPair<FIntPoint, TArray<FBoundaryEdge>>& Boundary : Boundaries)
+    {
+        TArray<FBoundaryEdge>& Edges = Boundary.Value;
 
-    PriorityQueue<FGraphNode> Frontier;
+        // Order the edges along the boundary so the picks are spread over its whole length
+        FBox EdgeBounds(ForceInit);
+        for (const FBoundaryEdge& Edge : Edges)
+        {
+            EdgeBounds += Graph.Positions[Edge.From];
+        }
+        const int32 Axis = EdgeBounds.GetExtent().X >= EdgeBounds.GetExtent().Y ? 0 : 1;
+        Edges.Sort([&Graph, Axis](const FBoundaryEdge& A, const FBoundaryEdge& B)
+        {
+            return Graph.Positions[A.From][Axis] < Graph.Positions[B.From][Axis];
+        });
 
-    // Use the index in GraphNodes array as the key in CameFrom and CostSoFar maps
-    TMap<int32, FGraphNode> CameFrom;
-    TArray<float> CostSoFar;
-    CostSoFar.Init(MAX_FLT, GraphNodes.Num());
+        const int32 NumPortals = FMath::Min(PortalsPerBoundary, Edges.Num());
+        for (int32 k = 0; k < NumPortals; ++k)
+        {
+            const int32 EdgeIndex = NumPortals == 1 ? Edges.Num() / 2 : (k * (Edges.Num() - 1)) / (NumPortals - 1);
+            const FBoundaryEdge& Edge = Edges[EdgeIndex];
 
-    // Initialize start node cost to 0
-    int32 StartNodeIndex = GraphNodes.IndexOfByKey(StartNode);
-    CostSoFar[StartNodeIndex] = 0;
+            const int32 FromPortal = GetOrAddPortal(Edge.From);
+            const int32 ToPortal = GetOrAddPortal(Edge.To);
+            AbstractEdges[FromPortal].Emplace(ToPortal, Edge.Cost);
+            AbstractEdges[ToPortal].Emplace(FromPortal, Edge.Cost);
+        }
+    }
 
-    Frontier.Enqueue(StartNode, 0);
-    CameFrom.Add(StartNodeIndex, StartNode);
+    // Group the portals per cluster
+    OutHierarchy.ClusterPortalOffsets.Init(0, OutHierarchy.NumClusters + 1);
+    for (const int32 Node : OutHierarchy.PortalNodes)
+    {
+        ++OutHierarchy.ClusterPortalOffsets[OutHierarchy.NodeClusters[Node] + 1];
+    }
+    for (int32 c = 0; c < OutHierarchy.NumClusters; ++c)
+    {
+        OutHierarchy.ClusterPortalOffsets[c + 1] += OutHierarchy.ClusterPortalOffsets[c];
+    }
 
-    while (!Frontier.IsEmpty())
+    OutHierarchy.ClusterPortals.SetNumUninitialized(OutHierarchy.PortalNodes.Num());
+    TArray<int32> ClusterFill(OutHierarchy.ClusterPortalOffsets.GetData(), OutHierarchy.NumClusters);
+    for (int32 Portal = 0; Portal < OutHierarchy.PortalNodes.Num(); ++Portal)
     {
-        FGraphNode Current = Frontier.Dequeue();
+        OutHierarchy.ClusterPortals[ClusterFill[OutHierarchy.NodeClusters[OutHierarchy.PortalNodes[Portal]]]++] = Portal;
+    }
 
-        if (Current.Position == EndNode.Position)
+    // Precompute the distance between every pair of portals inside the same cluster.
+    // A portal only belongs to one cluster, so each task only appends to its own portals' edge lists.
+    TArray<FPathfindSearchState> SearchStates;
+    ParallelForWithTaskContext(SearchStates, OutHierarchy.NumClusters, [&Graph, &OutHierarchy, &AbstractEdges](FPathfindSearchState& SearchState, int32 Cluster)
+    {
+        const TConstArrayView<int32> Portals = OutHierarchy.GetClusterPortals(Cluster);
+        if (Portals.Num() < 2)
         {
-            break;
+            return;
         }
 
-        int32 CurrentIndex = GraphNodes.IndexOfByKey(Current);
+        for (const int32 Portal : Portals)
+        {
+            PCGPathfindLocals::RunFilteredSearch(Graph, OutHierarchy.PortalNodes[Portal], INDEX_NONE, SearchState,
+                [&OutHierarchy, Cluster](int32 Node) { return OutHierarchy.NodeClusters[Node] == Cluster; });
+
+            for (const int32 OtherPortal : Portals)
+            {
+                const float Distance = SearchState.CostSoFar[OutHierarchy.PortalNodes[OtherPortal]];
+                if (OtherPortal != Portal && Distance < MAX_FLT)
+                {
+                    AbstractEdges[Portal].Emplace(OtherPortal, Distance);
+                }
+            }
+        }
+    });
+
+    // Flatten the portal graph into CSR
+    FPathfindGraph& AbstractGraph = OutHierarchy.AbstractGraph;
+    const int32 NumPortals = OutHierarchy.PortalNodes.Num();
+    AbstractGraph.ConnectionDistance = OutHierarchy.ClusterSize;
+    AbstractGraph.Positions.SetNumUninitialized(NumPortals);
+    AbstractGraph.Seeds.SetNumUninitialized(NumPortals);
+    AbstractGraph.AdjacencyOffsets.Init(0, NumPortals + 1);
+    for (int32 Portal = 0; Portal < NumPortals; ++Portal)
+    {
+        const int32 Node = OutHierarchy.PortalNodes[Portal];
+        AbstractGraph.Positions[Portal] = Graph.Positions[Node];
+        AbstractGraph.Seeds[Portal] = Graph.Seeds.IsValidIndex(Node) ? Graph.Seeds[Node] : 0;
+        AbstractGraph.AdjacencyOffsets[Portal + 1] = AbstractGraph.AdjacencyOffsets[Portal] + AbstractEdges[Portal].Num();
+    }
 
-        for (FGraphNode Next : GetNeighbors(Current, GraphNodes))
+    AbstractGraph.AdjacencyIndices.Reserve(AbstractGraph.AdjacencyOffsets[NumPortals]);
+    AbstractGraph.EdgeCosts.Reserve(AbstractGraph.AdjacencyOffsets[NumPortals]);
+    for (const TArray<TPair<int32, float>>& Edges : AbstractEdges)
+    {
+        for (const TPair<int32, float>& Edge : Edges)
         {
-            int32 NextIndex = GraphNodes.IndexOfByKey(Next);
+            AbstractGraph.AdjacencyIndices.Add(Edge.Key);
+            AbstractGraph.EdgeCosts.Add(Edge.Value);
+        }
+    }
+}
 
-            float NewCost = CostSoFar[CurrentIndex] + Cost(Current, Next);
-            float HeuristicValue = Heuristic(Next, EndNode);
+TArray<int32> UPCGPathfindHelper::FindPathHierarchical(const FPathfindGraph& Graph, const FPathfindHierarchy& Hierarchy, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::FindPathHierarchical);
 
-            // Add CostOffset to all costs to handle negative costs
-            //NewCost += CostOffset;
+    if (!Graph.IsValidIndex(StartIndex) || !Graph.IsValidIndex(EndIndex))
+    {
+        return TArray<int32>();
+    }
 
-            if (NewCost < CostSoFar[NextIndex] && NewCost != 999999.0f)
+    if (!Hierarchy.IsBuiltFor(Graph))
+    {
+        return FindPathIndices(Graph, StartIndex, EndIndex, SearchState);
+    }
+
+    const int32 StartCluster = Hierarchy.NodeClusters[StartIndex];
+    const int32 EndCluster = Hierarchy.NodeClusters[EndIndex];
+
+    // Short queries never leave their cluster
+    if (StartCluster == EndCluster &&
+        PCGPathfindLocals::RunFilteredSearch(Graph, StartIndex, EndIndex, SearchState,
+            [&Hierarchy, StartCluster](int32 Node) { return Hierarchy.NodeClusters[Node] == StartCluster; }))
+    {
+        return PCGPathfindLocals::ExtractPath(SearchState, EndIndex);
+    }
+
+    // Distance from the start and the end to the portals of their own cluster
+    auto GetPortalCosts = [&Graph, &Hierarchy, &SearchState](int32 Node, int32 Cluster)
+    {
+        TArray<TPair<int32, float>, TInlineAllocator<32>> PortalCosts;
+        PCGPathfindLocals::RunFilteredSearch(Graph, Node, INDEX_NONE, SearchState,
+            [&Hierarchy, Cluster](int32 Other) { return Hierarchy.NodeClusters[Other] == Cluster; });
+
+        for (const int32 Portal : Hierarchy.GetClusterPortals(Cluster))
+        {
+            const float Distance = SearchState.CostSoFar[Hierarchy.PortalNodes[Portal]];
+            if (Distance < MAX_FLT)
             {
-                CostSoFar[NextIndex] = NewCost;
-                float Priority = NewCost + HeuristicValue;
-                Frontier.Enqueue(Next, Priority);
-                CameFrom.Add(NextIndex, Current);
+                PortalCosts.Emplace(Portal, Distance);
             }
         }
+        return PortalCosts;
+    };
+
+    const auto StartPortalCosts = GetPortalCosts(StartIndex, StartCluster);
+    const auto EndPortalCosts = GetPortalCosts(EndIndex, EndCluster);
+
+    // A* over the portal graph, seeded with every start portal. The end node acts as a virtual goal
+    // reached through any end portal, so the search stops once nothing left can beat the best arrival.
+    const FPathfindGraph& AbstractGraph = Hierarchy.AbstractGraph;
+    const FVector Goal = Graph.Positions[EndIndex];
+
+    FPathfindSearchState AbstractState;
+    AbstractState.Reset(AbstractGraph.Num());
+
+    TMap<int32, float> EndCosts;
+    for (const TPair<int32, float>& PortalCost : EndPortalCosts)
+    {
+        EndCosts.Add(PortalCost.Key, PortalCost.Value);
     }
 
-    TArray<FPCGPoint> Path;
-    FGraphNode Current = EndNode;
+    for (const TPair<int32, float>& PortalCost : StartPortalCosts)
+    {
+        AbstractState.SetCost(PortalCost.Key, PortalCost.Value, INDEX_NONE);
+        AbstractState.Frontier.EnqueueOrDecrease(PortalCost.Key, PortalCost.Value + Heuristic(AbstractGraph.Positions[PortalCost.Key], Goal));
+    }
 
-    // Use a stack to reverse the order of nodes
-    TArray<FGraphNode> PathNodes;
-    const float DistanceThreshold = 0.1f; // Adjust this threshold as needed
-    while (FVector::Dist(Current.Position, StartNode.Position) > DistanceThreshold) {
-        int32 CurrentIndex = GraphNodes.IndexOfByKey(Current);
-        if (!CameFrom.Contains(CurrentIndex))
+    float BestCost = MAX_FLT;
+    int32 BestPortal = INDEX_NONE;
+    while (!AbstractState.Frontier.IsEmpty())
+    {
+        const int32 Current = AbstractState.Frontier.Dequeue();
+        const float CurrentCost = AbstractState.CostSoFar[Current];
+        if (CurrentCost + Heuristic(AbstractGraph.Positions[Current], Goal) >= BestCost)
         {
-            UE_LOG(LogTemp, Warning, TEXT("Could not find the previous node for node at position (%f, %f, %f)"), Current.Position.X, Current.Position.Y, Current.Position.Z);
-            return TArray<FPCGPoint>(); // return an empty path to indicate an error
+            break;
+        }
+
+        AbstractState.Closed[Current] = true;
+
+        if (const float* EndCost = EndCosts.Find(Current))
+        {
+            if (CurrentCost + *EndCost < BestCost)
+            {
+                BestCost = CurrentCost + *EndCost;
+                BestPortal = Current;
+            }
         }
 
-        PathNodes.Add(Current);
-        Current = CameFrom[CurrentIndex];
+        for (int32 Edge = AbstractGraph.AdjacencyOffsets[Current]; Edge < AbstractGraph.AdjacencyOffsets[Current + 1]; ++Edge)
+        {
+            const int32 Next = AbstractGraph.AdjacencyIndices[Edge];
+            const float NewCost = CurrentCost + AbstractGraph.EdgeCosts[Edge];
+            if (!AbstractState.Closed[Next] && NewCost < AbstractState.CostSoFar[Next])
+            {
+                AbstractState.SetCost(Next, NewCost, Current);
+                AbstractState.Frontier.EnqueueOrDecrease(Next, NewCost + Heuristic(AbstractGraph.Positions[Next], Goal));
+            }
+        }
     }
 
-    // Add the start node to the path
-    PathNodes.Add(StartNode);
+    if (BestPortal == INDEX_NONE)
+    {
+        // The portal graph is a simplification, it can miss connections the full graph has
+        return FindPathIndices(Graph, StartIndex, EndIndex, SearchState);
+    }
 
-    // Reverse the order of nodes
-    Algo::Reverse(PathNodes);
+    // Refine on the full graph, restricted to the clusters the coarse path goes through
+    TBitArray<> Corridor(false, Hierarchy.NumClusters);
+    Corridor[StartCluster] = true;
+    Corridor[EndCluster] = true;
+    for (int32 Portal = BestPortal; Portal != INDEX_NONE; Portal = AbstractState.Parents[Portal])
+    {
+        Corridor[Hierarchy.NodeClusters[Hierarchy.PortalNodes[Portal]]] = true;
+    }
+
+    if (PCGPathfindLocals::RunFilteredSearch(Graph, StartIndex, EndIndex, SearchState,
+        [&Hierarchy, &Corridor](int32 Node) { return Corridor[Hierarchy.NodeClusters[Node]]; }))
+    {
+        return PCGPathfindLocals::ExtractPath(SearchState, EndIndex);
+    }
+
+    return FindPathIndices(Graph, StartIndex, EndIndex, SearchState);
+}
+
+// FINAL DESTINATION
+TArray<FPCGPoint> UPCGPathfindHelper::FindPath(const FPCGPoint& StartPoint, const FPCGPoint& EndPoint, const TArray<FPCGPoint>& PathPoints)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UPCGPathfindHelper::FindPath);
+
+    FPathfindGraph Graph;
+    BuildGraph(PathPoints, Graph);
+
+    const int32 StartIndex = FindNodeIndex(Graph, StartPoint);
+    const int32 EndIndex = FindNodeIndex(Graph, EndPoint);
+
+    FPathfindSearchState SearchState;
+    const TArray<int32> PathIndices = FindPathIndices(Graph, StartIndex, EndIndex, SearchState);
+
+    TArray<FPCGPoint> Path;
+    if (PathIndices.IsEmpty())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("Could not find a path between (%s) and (%s)"), *StartPoint.Transform.GetLocation().ToString(), *EndPoint.Transform.GetLocation().ToString());
+        return Path; // return an empty path to indicate an error
+    }
 
     // Convert path nodes to FPCGPoint
-    for (const FGraphNode& Node : PathNodes)
+    Path.Reserve(PathIndices.Num());
+    for (const int32 NodeIndex : PathIndices)
     {
-        Path.Add(ConvertToPCGPoint(FCustomPoint(Node.Position)));
+        Path.Add(ConvertToPCGPoint(FCustomPoint(Graph.Positions[NodeIndex])));
     }
 
     return Path;
@@ -258,4 +939,4 @@ FPCGPoint UPCGPathfindHelper::ConvertToPCGPoint(const FCustomPoint& Point)
     FPCGPoint Result;
     Result.Transform.SetLocation(FVector(Point.X, Point.Y, Point.Z));
     return Result;
-}
\ No newline at end of file
+}
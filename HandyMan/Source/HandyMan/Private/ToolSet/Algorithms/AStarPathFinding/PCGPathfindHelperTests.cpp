@@ -0,0 +1,77 @@
+// PCGPathfindHelperTests.cpp
+
+#include "Misc/AutomationTest.h"
+#include "ToolSet/Algorithms/AStarPathFinding/PCGPathfindHelper.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace PCGPathfindHelperTestLocals
+{
+    constexpr double Spacing = 100.0;
+
+    TArray<FPCGPoint> MakeGridPoints(int32 NumX, int32 NumY)
+    {
+        TArray<FPCGPoint> Points;
+        for (int32 y = 0; y < NumY; ++y)
+        {
+            for (int32 x = 0; x < NumX; ++x)
+            {
+                FPCGPoint& Point = Points.AddDefaulted_GetRef();
+                Point.Transform.SetLocation(FVector(x * Spacing, y * Spacing, 0.0));
+                Point.Seed = Points.Num();
+            }
+        }
+        return Points;
+    }
+
+    // Edges of a node at (x, y) on a NumX by NumY grid, axis and diagonal neighbors included
+    int32 ExpectedNeighborCount(int32 x, int32 y, int32 NumX, int32 NumY)
+    {
+        int32 Count = 0;
+        for (int32 dy = -1; dy <= 1; ++dy)
+        {
+            for (int32 dx = -1; dx <= 1; ++dx)
+            {
+                const int32 NX = x + dx, NY = y + dy;
+                Count += (dx != 0 || dy != 0) && NX >= 0 && NX < NumX && NY >= 0 && NY < NumY;
+            }
+        }
+        return Count;
+    }
+
+    void TestGrid(FAutomationTestBase& Test, int32 NumX, int32 NumY)
+    {
+        FPathfindGraph Graph;
+        UPCGPathfindHelper::BuildGraph(MakeGridPoints(NumX, NumY), Graph);
+
+        const FString Grid = FString::Printf(TEXT("%dx%d"), NumX, NumY);
+        Test.TestTrue(Grid + TEXT(" connection distance reaches diagonals"), Graph.ConnectionDistance >= Spacing * UE_DOUBLE_SQRT_2);
+        Test.TestTrue(Grid + TEXT(" connection distance stays below two cells"), Graph.ConnectionDistance < 2.0 * Spacing);
+
+        for (int32 y = 0; y < NumY; ++y)
+        {
+            for (int32 x = 0; x < NumX; ++x)
+            {
+                Test.TestEqual(FString::Printf(TEXT("%s neighbors of (%d, %d)"), *Grid, x, y),
+                    Graph.GetNeighbors(y * NumX + x).Num(), ExpectedNeighborCount(x, y, NumX, NumY));
+            }
+        }
+    }
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPCGPathfindGridConnectionTest, "HandyMan.Pathfinding.GridConnection",
+    EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPCGPathfindGridConnectionTest::RunTest(const FString& Parameters)
+{
+    using namespace PCGPathfindHelperTestLocals;
+
+    TestGrid(*this, 3, 3);
+    TestGrid(*this, 2, 10);
+    TestGrid(*this, 10, 2);
+    TestGrid(*this, 16, 16);
+
+    return true;
+}
+
+#endif
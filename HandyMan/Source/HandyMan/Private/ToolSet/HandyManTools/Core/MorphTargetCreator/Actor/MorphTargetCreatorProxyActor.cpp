@@ -11,6 +11,106 @@
 #include "DynamicMesh/NonManifoldMappingSupport.h"
 #include "GeometryScript/MeshAssetFunctions.h"
 #include "GeometryScript/MeshDecompositionFunctions.h"
+#include "Async/ParallelFor.h"
+#include "Math/VectorRegister.h"
+
+namespace MorphTargetCreatorLocals
+{
+	// Vertices handled by one ParallelFor task, a multiple of the SIMD width
+	static constexpr int32 DeltaBatchSize = 4096;
+
+	/**
+	 * Collects every vertex whose offset is longer than the threshold into OutDelta, sorted by buffer index.
+	 * The offset is Positions - BasePositions, or Positions itself when BasePositions is null.
+	 * Four vertices are tested per SIMD compare and the resulting lane mask picks the ones to keep.
+	 */
+	static void BuildSparseDelta(const FMorphPositionBuffer& Positions, const FMorphPositionBuffer* BasePositions, const TArray<int32>& VertexIDs, const float ThresholdSquared, FMorphTargetSparseDelta& OutDelta)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(MorphTargetCreator::BuildSparseDelta);
+
+		const int32 NumVertices = Positions.Num();
+		const int32 NumBatches = FMath::DivideAndRoundUp(NumVertices, DeltaBatchSize);
+
+		TArray<FMorphTargetSparseDelta> BatchDeltas;
+		BatchDeltas.SetNum(NumBatches);
+
+		ParallelFor(NumBatches, [&](int32 BatchIndex)
+		{
+			const int32 Begin = BatchIndex * DeltaBatchSize;
+			const int32 End = FMath::Min(Begin + DeltaBatchSize, NumVertices);
+			FMorphTargetSparseDelta& BatchDelta = BatchDeltas[BatchIndex];
+
+			const float* PX = Positions.X.GetData();
+			const float* PY = Positions.Y.GetData();
+			const float* PZ = Positions.Z.GetData();
+			const float* BX = BasePositions ? BasePositions->X.GetData() : nullptr;
+			const float* BY = BasePositions ? BasePositions->Y.GetData() : nullptr;
+			const float* BZ = BasePositions ? BasePositions->Z.GetData() : nullptr;
+
+			auto GetOffset = [&](int32 Index)
+			{
+				return BasePositions
+					? FVector3f(PX[Index] - BX[Index], PY[Index] - BY[Index], PZ[Index] - BZ[Index])
+					: FVector3f(PX[Index], PY[Index], PZ[Index]);
+			};
+
+			auto AddVertex = [&](int32 Index, const FVector3f& Offset)
+			{
+				BatchDelta.VertexIDs.Add(VertexIDs[Index]);
+				BatchDelta.Deltas.Add(Offset);
+			};
+
+			const VectorRegister4Float Threshold = VectorSetFloat1(ThresholdSquared);
+
+			int32 Index = Begin;
+			for (; Index + 4 <= End; Index += 4)
+			{
+				VectorRegister4Float DX = VectorLoad(PX + Index);
+				VectorRegister4Float DY = VectorLoad(PY + Index);
+				VectorRegister4Float DZ = VectorLoad(PZ + Index);
+				if (BasePositions)
+				{
+					DX = VectorSubtract(DX, VectorLoad(BX + Index));
+					DY = VectorSubtract(DY, VectorLoad(BY + Index));
+					DZ = VectorSubtract(DZ, VectorLoad(BZ + Index));
+				}
+
+				const VectorRegister4Float LengthSquared = VectorMultiplyAdd(DZ, DZ, VectorMultiplyAdd(DY, DY, VectorMultiply(DX, DX)));
+				uint32 LaneMask = static_cast<uint32>(VectorMaskBits(VectorCompareGT(LengthSquared, Threshold)));
+				while (LaneMask != 0)
+				{
+					const int32 Lane = static_cast<int32>(FMath::CountTrailingZeros(LaneMask));
+					AddVertex(Index + Lane, GetOffset(Index + Lane));
+					LaneMask &= LaneMask - 1;
+				}
+			}
+
+			for (; Index < End; ++Index)
+			{
+				const FVector3f Offset = GetOffset(Index);
+				if (Offset.SquaredLength() > ThresholdSquared)
+				{
+					AddVertex(Index, Offset);
+				}
+			}
+		});
+
+		int32 NumDeltas = 0;
+		for (const FMorphTargetSparseDelta& BatchDelta : BatchDeltas)
+		{
+			NumDeltas += BatchDelta.Num();
+		}
+
+		OutDelta.Reset();
+		OutDelta.VertexIDs.Reserve(NumDeltas);
+		OutDelta.Deltas.Reserve(NumDeltas);
+		for (const FMorphTargetSparseDelta& BatchDelta : BatchDeltas)
+		{
+			OutDelta.VertexIDs.Append(BatchDelta.VertexIDs);
+			OutDelta.Deltas.Append(BatchDelta.Deltas);
+		}
+	}
+}
 
 
 // Sets default values
@@ -60,92 +160,111 @@ void AMorphTargetCreatorProxyActor::CacheBaseMesh(USkeletalMesh* InputMesh)
 
 	if(!BaseMesh) return;
 
+	CacheVertexMapping();
+
 	UDynamicMesh* OutMesh;
 	UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh(BaseMesh, FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(), OutMesh);
 }
 
+void AMorphTargetCreatorProxyActor::CacheVertexMapping()
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(AMorphTargetCreatorProxyActor::CacheVertexMapping);
+
+	const FDynamicMesh3& Mesh = BaseMesh->GetMeshRef();
+	const UE::Geometry::FNonManifoldMappingSupport NonManifoldMappingSupport(Mesh);
+
+	BaseVertexIDs.Reset(Mesh.VertexCount());
+	DescriptionVertexIDs.Init(INDEX_NONE, Mesh.MaxVertexID());
+	NumDescriptionVertices = 0;
+
+	// Split non-manifold vertices point back at the same mesh description vertex, count those only once
+	TBitArray<> SeenDescriptionVertices;
+	for (const int32 VertexID : Mesh.VertexIndicesItr())
+	{
+		const int32 DescriptionVertexID = NonManifoldMappingSupport.GetOriginalNonManifoldVertexID(VertexID);
+		BaseVertexIDs.Add(VertexID);
+		DescriptionVertexIDs[VertexID] = DescriptionVertexID;
+
+		if (DescriptionVertexID >= SeenDescriptionVertices.Num())
+		{
+			SeenDescriptionVertices.SetNum(DescriptionVertexID + 1, false);
+		}
+		if (!SeenDescriptionVertices[DescriptionVertexID])
+		{
+			SeenDescriptionVertices[DescriptionVertexID] = true;
+			++NumDescriptionVertices;
+		}
+	}
+
+	BasePositions.SetNumZeroed(BaseVertexIDs.Num());
+	ParallelFor(BaseVertexIDs.Num(), [&](int32 Index)
+	{
+		BasePositions.Set(Index, FVector3f(Mesh.GetVertex(BaseVertexIDs[Index])));
+	});
+}
+
+float AMorphTargetCreatorProxyActor::GetMorphThresholdSquared() const
+{
+	const FSkeletalMeshLODInfo* LODInfo = MorphTargetMesh ? MorphTargetMesh->GetLODInfo(0) : nullptr;
+	return LODInfo ? FMath::Square(LODInfo->BuildSettings.MorphThresholdPosition) : 0.f;
+}
+
+TArray<FName> AMorphTargetCreatorProxyActor::GetMorphTargetMeshNames() const
+{
+	TArray<FName> MorphTargetMeshNames;
+	MorphTargetDeltaMap.GetKeys(MorphTargetMeshNames);
+	return MorphTargetMeshNames;
+}
+
 void AMorphTargetCreatorProxyActor::RemoveMorphTargetMesh(const FName& MorphTargetMeshName)
 {
 	if(MorphTargetMeshName.IsEqual(NAME_None)) return;
 
-	if(!MorphTargetMeshMap.Contains(MorphTargetMeshName)) return;
+	if(!MorphTargetDeltaMap.Contains(MorphTargetMeshName)) return;
 
-	MorphTargetMeshMap.Remove(MorphTargetMeshName);
+	MorphTargetDeltaMap.Remove(MorphTargetMeshName);
 
-	
+	// The component still shows the removed morph, make sure it doesn't get stored back under its name
+	if (ActiveMorphTarget.IsEqual(MorphTargetMeshName))
+	{
+		ActiveMorphTarget = NAME_None;
+	}
 }
 
 void AMorphTargetCreatorProxyActor::RemoveAllMorphTargetMeshes(const bool bShouldRestoreMesh)
 {
-	for (const auto MeshMap : MorphTargetMeshMap)
-	{
-		RemoveMorphTargetMesh(MeshMap.Key);
-	}
+	MorphTargetDeltaMap.Empty();
+	ActiveMorphTarget = NAME_None;
 
 	if (bShouldRestoreMesh)
 	{
 		RestoreLastMorphTarget();
 	}
-	else
+	else if (UDynamicMesh* EditMesh = GetEditMesh())
 	{
-		UDynamicMesh* OutMesh;
-		UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh(BaseMesh, FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(), OutMesh);
+		ApplyMorphTargetDelta(FMorphTargetSparseDelta(), EditMesh);
 	}
 }
 
 void AMorphTargetCreatorProxyActor::CreateMorphTargetMesh(const FName& MorphTargetMeshName)
 {
-	// Copy the base mesh into another allocated mesh and add it to the map. Set that mesh as the components mesh
+	// A new morph starts as an empty delta, so the component just goes back to the base mesh.
+	// Activating it stores whatever was sculpted on the previous morph first.
 	if(MorphTargetMeshName.IsEqual(NAME_None)) return;
-	if(!MorphTargetMesh) return;
-
-	// Copy the last morph mesh into the object we previously created
-	if (MorphTargetMeshMap.Num() > 0)
-	{
-		StoreLastMorphTarget();
-	}
-	
-	UDynamicMesh* NewMorph = NewObject<UDynamicMesh>(this);
-	
-	if(!NewMorph) return;
-	
-	
-	FGeometryScriptCopyMeshFromAssetOptions CopyFromAssetOptions;
-	CopyFromAssetOptions.bRequestTangents = true;
-	CopyFromAssetOptions.bApplyBuildSettings = false;
-
-	FGeometryScriptMeshReadLOD MeshRead;
-	MeshRead.LODType = EGeometryScriptLODType::HiResSourceModel;
-
-	EGeometryScriptOutcomePins CopyFromAssetOutcome;
-	NewMorph = UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromSkeletalMesh(MorphTargetMesh, NewMorph, CopyFromAssetOptions, MeshRead, CopyFromAssetOutcome);
-
-	if(!NewMorph) return;
-	
-	UDynamicMesh* OutMesh;
-	NewMorph = UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh(NewMorph, FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(), OutMesh);
-
-	MorphTargetMeshMap.Add(MorphTargetMeshName, NewMorph);
+	if(!MorphTargetMesh || !BaseMesh) return;
 
-	
-	
+	MorphTargetDeltaMap.Add(MorphTargetMeshName);
+	ActivateMorphTarget(MorphTargetMeshName);
 }
 
 void AMorphTargetCreatorProxyActor::CloneMorphTarget(const FName& MorphTargetName, const FName& NewMorphTargetName)
 {
 
-	if(!MorphTargetMesh) return;
+	if(!MorphTargetMesh || !BaseMesh) return;
 
-	// Copy the last morph mesh into the object we previously created
-	if (MorphTargetMeshMap.Num() > 0)
-	{
-		StoreLastMorphTarget();
-	}
-	
-	UDynamicMesh* Mesh = FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh();
 	FMeshDescription* MeshDescription = MorphTargetMesh->GetMeshDescription(0);
 	
-	if(!Mesh || MorphTargetName.IsEqual(NAME_None) || MeshDescription == nullptr) return;
+	if(MorphTargetName.IsEqual(NAME_None) || MeshDescription == nullptr) return;
 
 	FSkeletalMeshAttributes MeshAttributes(*MeshDescription);
 	MeshAttributes.Register();
@@ -155,117 +274,76 @@ void AMorphTargetCreatorProxyActor::CloneMorphTarget(const FName& MorphTargetNam
 		return;
 	}
 	
-	FGeometryScriptCopyMeshFromAssetOptions CopyFromAssetOptions;
-	CopyFromAssetOptions.bRequestTangents = true;
-	CopyFromAssetOptions.bApplyBuildSettings = false;
-
-	FGeometryScriptMeshReadLOD MeshRead;
-	MeshRead.LODType = EGeometryScriptLODType::HiResSourceModel;
-
-	EGeometryScriptOutcomePins CopyFromAssetOutcome;
-	UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromSkeletalMesh(MorphTargetMesh, Mesh, CopyFromAssetOptions, MeshRead, CopyFromAssetOutcome);
-	
-	const FSkeletalMeshLODInfo* LODInfo = MorphTargetMesh->GetLODInfo(0);
-	const float MorphThresholdSquared = LODInfo->BuildSettings.MorphThresholdPosition * LODInfo->BuildSettings.MorphThresholdPosition;
-	
-	/*TVertexAttributesRef<FVector3f> PositionDelta = MeshAttributes.GetVertexMorphPositionDelta(MorphTargetName);
-	TVertexAttributesRef<FVector3f> VertexPositions = MeshAttributes.GetVertexPositions();*/
+	if (MeshDescription->Vertices().Num() != NumDescriptionVertices)
+	{
+		return;
+	}
 
-	
 	TVertexAttributesRef<FVector3f> MorphTargetPositions = MeshAttributes.GetVertexMorphPositionDelta(MorphTargetName);
 
-
-	const FDynamicMesh3& SourceMesh = Mesh->GetMeshRef();
-	const UE::Geometry::FNonManifoldMappingSupport NonManifoldMappingSupport(SourceMesh);
-	int32 SourceVertexCount;
-
-	if (NonManifoldMappingSupport.IsNonManifoldVertexInSource())
+	// Gather the morph deltas in base mesh order, then keep only the vertices the morph actually moves
+	ScratchPositions.SetNumZeroed(BaseVertexIDs.Num());
+	ParallelFor(BaseVertexIDs.Num(), [&](int32 Index)
 	{
-		TSet<int32> UniqueVertices;
-		for (int32 SourceVID = 0; SourceVID < SourceMesh.VertexCount(); ++SourceVID)
-		{
-			UniqueVertices.Add(NonManifoldMappingSupport.GetOriginalNonManifoldVertexID(SourceVID));
-		}
+		ScratchPositions.Set(Index, MorphTargetPositions[DescriptionVertexIDs[BaseVertexIDs[Index]]]);
+	});
 
-		SourceVertexCount = UniqueVertices.Num();
-	}
-	else
-	{
-		SourceVertexCount = SourceMesh.VertexCount();
-	}
-	if (MeshDescription->Vertices().Num() != SourceVertexCount)
-	{
-		return;
-	}
-	
-	for (int32 SourceVID = 0; SourceVID < SourceMesh.VertexCount(); ++SourceVID)
-	{
-		const int32 TargetVID = NonManifoldMappingSupport.GetOriginalNonManifoldVertexID(SourceVID);
-		
-		const FVector3f V0 = MorphTargetPositions[TargetVID];
-		const FVector3d V1 = Mesh->GetMeshRef().GetVertex(SourceVID);
+	FMorphTargetSparseDelta NewMorph;
+	MorphTargetCreatorLocals::BuildSparseDelta(ScratchPositions, nullptr, BaseVertexIDs, GetMorphThresholdSquared(), NewMorph);
 
-		const FVector3f Delta = V0 + FVector3f{V1};
-		if (Delta.SquaredLength() > MorphThresholdSquared)
-		{
-			Mesh->GetMeshRef().SetVertex(TargetVID, (FVector3d)Delta);
-		}
-	}
+	const FName MorphTargetMeshName = NewMorphTargetName.IsEqual(NAME_None) ? MorphTargetName : NewMorphTargetName;
+	MorphTargetDeltaMap.Add(MorphTargetMeshName, MoveTemp(NewMorph));
+	ActivateMorphTarget(MorphTargetMeshName);
+}
 
-	UDynamicMesh* NewMorph = NewObject<UDynamicMesh>(this);
-	UDynamicMesh* OutMesh;
-	UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh
-	(
-		FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(),
-		NewMorph,
-		OutMesh
-	);
-
-	if (NewMorphTargetName.IsEqual(NAME_None))
-	{
-		MorphTargetMeshMap.Add(MorphTargetName, NewMorph);
-	}
-	else
+void AMorphTargetCreatorProxyActor::ActivateMorphTarget(const FName& MorphTargetName)
+{
+	const FMorphTargetSparseDelta* Delta = MorphTargetDeltaMap.Find(MorphTargetName);
+	UDynamicMesh* EditMesh = GetEditMesh();
+	if (!Delta || !EditMesh) return;
+
+	if (!ActiveMorphTarget.IsEqual(MorphTargetName))
 	{
-		MorphTargetMeshMap.Add(NewMorphTargetName, NewMorph);
+		StoreActiveMorphTarget();
 	}
 
+	ApplyMorphTargetDelta(*Delta, EditMesh);
+	ActiveMorphTarget = MorphTargetName;
 }
 
-void AMorphTargetCreatorProxyActor::StoreLastMorphTarget()
+void AMorphTargetCreatorProxyActor::StoreActiveMorphTarget()
 {
-	TArray<FName> MorphTargetMeshNames;
-	MorphTargetMeshMap.GetKeys(MorphTargetMeshNames);
-	const FName MorphTargetMeshNameKey = MorphTargetMeshNames.Last();
+	FMorphTargetSparseDelta* Delta = MorphTargetDeltaMap.Find(ActiveMorphTarget);
+	const UDynamicMesh* EditMesh = GetEditMesh();
+	if (!Delta || !EditMesh || !BaseMesh) return;
 
-	if (MorphTargetMeshMap.Contains(MorphTargetMeshNameKey))
+	// Diff the sculpted mesh against the base, the topology never changes while sculpting so vertex ids line up
+	const FDynamicMesh3& Base = BaseMesh->GetMeshRef();
+	const FDynamicMesh3& Sculpted = EditMesh->GetMeshRef();
+	if (Base.MaxVertexID() != Sculpted.MaxVertexID()) return;
+
+	ScratchPositions.SetNumZeroed(BaseVertexIDs.Num());
+	ParallelFor(BaseVertexIDs.Num(), [&](int32 Index)
 	{
-		UDynamicMesh* OutMesh;
-		UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh
-		(
-			FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(),
-			MorphTargetMeshMap[MorphTargetMeshNameKey],
-			OutMesh
-		);
-		
-	}
+		ScratchPositions.Set(Index, FVector3f(Sculpted.GetVertex(BaseVertexIDs[Index])));
+	});
+
+	// Keep every moved vertex at full precision while sculpting, the asset threshold is only applied on save
+	MorphTargetCreatorLocals::BuildSparseDelta(ScratchPositions, &BasePositions, BaseVertexIDs, 0.f, *Delta);
+	Delta->VertexIDs.Shrink();
+	Delta->Deltas.Shrink();
 }
 
 void AMorphTargetCreatorProxyActor::RestoreLastMorphTarget()
 {
-	TArray<FName> MorphTargetMeshNames;
-	MorphTargetMeshMap.GetKeys(MorphTargetMeshNames);
-	const FName MorphTargetMeshNameKey = MorphTargetMeshNames.Last();
-
-	if (MorphTargetMeshMap.Contains(MorphTargetMeshNameKey))
+	TArray<FName> MorphTargetMeshNames = GetMorphTargetMeshNames();
+	if (MorphTargetMeshNames.Num() > 0)
 	{
-		UDynamicMesh* OutMesh;
-		UGeometryScriptLibrary_MeshDecompositionFunctions::CopyMeshToMesh
-		(
-			MorphTargetMeshMap[MorphTargetMeshNameKey],
-			FindComponentByClass<UDynamicMeshComponent>()->GetDynamicMesh(),
-			OutMesh
-		);
+		ActivateMorphTarget(MorphTargetMeshNames.Last());
+	}
+	else if (UDynamicMesh* EditMesh = GetEditMesh())
+	{
+		ApplyMorphTargetDelta(FMorphTargetSparseDelta(), EditMesh);
 	}
 }
 
@@ -282,13 +360,42 @@ void AMorphTargetCreatorProxyActor::SaveObject(UDynamicMesh* TargetMesh)
 	FGeometryScriptMeshWriteLOD LodSettings;
 	LodSettings.LODIndex = 0;
 
-	// Copy the last mesh version into the last morph target entry;
-	StoreLastMorphTarget();
+	// Copy the last mesh version into the active morph target entry;
+	StoreActiveMorphTarget();
 
-	
-	for (const auto Morph : MorphTargetMeshMap)
+	if (BaseMesh)
 	{
-		auto CopiedMesh = UGeometryScriptLibrary_StaticMeshFunctions::CopyMorphTargetToSkeletalMesh(Morph.Value, MorphTargetMesh, Morph.Key, CopyToMeshOptions, LodSettings , CopyToMeshOutcome);
+		// Reuse one scratch mesh for every morph, only the vertices a morph touched are written and then put back
+		UDynamicMesh* MorphMesh = NewObject<UDynamicMesh>(this);
+		MorphMesh->SetMesh(BaseMesh->GetMeshRef());
+		const float MorphThresholdSquared = GetMorphThresholdSquared();
+
+		for (const auto& Morph : MorphTargetDeltaMap)
+		{
+			const FMorphTargetSparseDelta& Delta = Morph.Value;
+			const FDynamicMesh3& Base = BaseMesh->GetMeshRef();
+
+			MorphMesh->EditMesh([&Delta, &Base, MorphThresholdSquared](FDynamicMesh3& EditMesh)
+			{
+				for (int32 i = 0; i < Delta.Num(); ++i)
+				{
+					if (Delta.Deltas[i].SquaredLength() <= MorphThresholdSquared) continue;
+					
+					const int32 VertexID = Delta.VertexIDs[i];
+					EditMesh.SetVertex(VertexID, Base.GetVertex(VertexID) + FVector3d(Delta.Deltas[i]));
+				}
+			}, EDynamicMeshChangeType::DeformationEdit, EDynamicMeshAttributeChangeFlags::VertexPositions, true);
+
+			UGeometryScriptLibrary_StaticMeshFunctions::CopyMorphTargetToSkeletalMesh(MorphMesh, MorphTargetMesh, Morph.Key, CopyToMeshOptions, LodSettings , CopyToMeshOutcome);
+
+			MorphMesh->EditMesh([&Delta, &Base](FDynamicMesh3& EditMesh)
+			{
+				for (const int32 VertexID : Delta.VertexIDs)
+				{
+					EditMesh.SetVertex(VertexID, Base.GetVertex(VertexID));
+				}
+			}, EDynamicMeshChangeType::DeformationEdit, EDynamicMeshAttributeChangeFlags::VertexPositions, true);
+		}
 	}
 
 	
@@ -301,3 +408,24 @@ void AMorphTargetCreatorProxyActor::SaveObject(UDynamicMesh* TargetMesh)
 	RerunConstructionScripts();
 }
 
+UDynamicMesh* AMorphTargetCreatorProxyActor::GetEditMesh() const
+{
+	UDynamicMeshComponent* Component = FindComponentByClass<UDynamicMeshComponent>();
+	return Component ? Component->GetDynamicMesh() : nullptr;
+}
+
+void AMorphTargetCreatorProxyActor::ApplyMorphTargetDelta(const FMorphTargetSparseDelta& Delta, UDynamicMesh* TargetMesh) const
+{
+	if (!BaseMesh || !TargetMesh) return;
+
+	const FDynamicMesh3& Base = BaseMesh->GetMeshRef();
+	TargetMesh->EditMesh([&Delta, &Base](FDynamicMesh3& EditMesh)
+	{
+		EditMesh = Base;
+		for (int32 i = 0; i < Delta.Num(); ++i)
+		{
+			const int32 VertexID = Delta.VertexIDs[i];
+			EditMesh.SetVertex(VertexID, Base.GetVertex(VertexID) + FVector3d(Delta.Deltas[i]));
+		}
+	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown, false);
+}
@@ -7,6 +7,69 @@
 
 class UDynamicMesh;
 
+/**
+ * Sculpted offsets of a single morph target relative to the shared base mesh.
+ * Only the vertices that actually moved are stored, so memory scales with the sculpted area rather than the mesh size.
+ */
+struct FMorphTargetSparseDelta
+{
+	// Vertex ids of the base mesh, sorted ascending
+	TArray<int32> VertexIDs;
+
+	// Offset of every vertex in VertexIDs from its base position
+	TArray<FVector3f> Deltas;
+
+	int32 Num() const
+	{
+		return VertexIDs.Num();
+	}
+
+	void Reset()
+	{
+		VertexIDs.Reset();
+		Deltas.Reset();
+	}
+
+	SIZE_T GetAllocatedSize() const
+	{
+		return VertexIDs.GetAllocatedSize() + Deltas.GetAllocatedSize();
+	}
+};
+
+/** Vertex positions split into one array per component, so the delta kernel can load four vertices per SIMD register. */
+struct FMorphPositionBuffer
+{
+	TArray<float> X;
+	TArray<float> Y;
+	TArray<float> Z;
+
+	int32 Num() const
+	{
+		return X.Num();
+	}
+
+	void SetNumZeroed(int32 NumVertices)
+	{
+		X.SetNumZeroed(NumVertices);
+		Y.SetNumZeroed(NumVertices);
+		Z.SetNumZeroed(NumVertices);
+	}
+
+	void Set(int32 Index, const FVector3f& Position)
+	{
+		X[Index] = Position.X;
+		Y[Index] = Position.Y;
+		Z[Index] = Position.Z;
+	}
+
+	void Reset()
+	{
+		X.Reset();
+		Y.Reset();
+		Z.Reset();
+	}
+};
+
 UCLASS()
 class HANDYMAN_API AMorphTargetCreatorProxyActor : public AActor
 {
@@ -40,8 +103,10 @@ public:
 
 private:
 
-	UPROPERTY()
-	TMap<FName, TObjectPtr<UDynamicMesh>> MorphTargetMeshMap;
+	// Every morph being edited, in creation order. The active one lives in the component mesh until it is stored back.
+	TMap<FName, FMorphTargetSparseDelta> MorphTargetDeltaMap;
+
+	FName ActiveMorphTarget = NAME_None;
 
 	UPROPERTY()
 	TObjectPtr<USkeletalMesh> MorphTargetMesh;
@@ -50,12 +115,15 @@ private:
 public:
 
 	void CacheBaseMesh(USkeletalMesh* InputMesh);
-	TMap<FName, TObjectPtr<UDynamicMesh>> GetMorphTargetMeshMap() { return MorphTargetMeshMap; }
+	TArray<FName> GetMorphTargetMeshNames() const;
+	int32 GetNumMorphTargetMeshes() const { return MorphTargetDeltaMap.Num(); }
+	FName GetActiveMorphTarget() const { return ActiveMorphTarget; }
 	void RemoveMorphTargetMesh(const FName& MorphTargetMeshName);
 	void RemoveAllMorphTargetMeshes(const bool bShouldRestoreMesh = false);
 	void CreateMorphTargetMesh(const FName& MorphTargetMeshName);
 	void CloneMorphTarget(const FName& MorphTargetName, const FName& NewMorphTargetName);
-	void StoreLastMorphTarget();
+	void ActivateMorphTarget(const FName& MorphTargetName);
+	void StoreActiveMorphTarget();
 	void RestoreLastMorphTarget();
 	void SaveObject(UDynamicMesh* TargetMesh);
 
@@ -68,4 +136,22 @@ private:
 
 	bool bShouldStoreMeshIntoAsset = false;
 
+	UDynamicMesh* GetEditMesh() const;
+
+	// Built once per base mesh and reused by every store and clone of the tool session.
+	// Vertex ids of the base mesh in buffer order, and the mesh description vertex every base mesh vertex came from.
+	TArray<int32> BaseVertexIDs;
+	TArray<int32> DescriptionVertexIDs;
+	int32 NumDescriptionVertices = 0;
+	FMorphPositionBuffer BasePositions;
+
+	// Scratch buffer for the positions being diffed against BasePositions
+	FMorphPositionBuffer ScratchPositions;
+
+	void CacheVertexMapping();
+	float GetMorphThresholdSquared() const;
+
+	// Writes the base mesh plus the given deltas into TargetMesh
+	void ApplyMorphTargetDelta(const FMorphTargetSparseDelta& Delta, UDynamicMesh* TargetMesh) const;
+
 };
@@ -3,5 +3,190 @@
 
 #include "MorphTargetCreatorTypes.h"
 
+#include "Changes/MeshVertexChange.h"
+#include "Components/DynamicMeshComponent.h"
+#include "DynamicMesh/DynamicMesh3.h"
 
+using namespace UE::Geometry;
 
+namespace
+{
+	// LEB128, seven bits per byte with the high bit marking that more bytes follow
+	static void WriteVarInt(TArray<uint8>& Bytes, uint64 Value)
+	{
+		while (Value >= 0x80)
+		{
+			Bytes.Add(static_cast<uint8>(Value | 0x80));
+			Value >>= 7;
+		}
+		Bytes.Add(static_cast<uint8>(Value));
+	}
+
+	static uint64 ReadVarInt(const TArray<uint8>& Bytes, int32& Offset)
+	{
+		uint64 Value = 0;
+		for (int32 Shift = 0; ; Shift += 7)
+		{
+			const uint8 Byte = Bytes[Offset++];
+			Value |= static_cast<uint64>(Byte & 0x7F) << Shift;
+			if ((Byte & 0x80) == 0)
+			{
+				return Value;
+			}
+		}
+	}
+
+	// Interleaves signs so small negative values stay small
+	static uint64 ZigZagEncode(const int64 Value)
+	{
+		return (static_cast<uint64>(Value) << 1) ^ static_cast<uint64>(Value >> 63);
+	}
+
+	static int64 ZigZagDecode(const uint64 Value)
+	{
+		return static_cast<int64>(Value >> 1) ^ -static_cast<int64>(Value & 1);
+	}
+}
+
+
+FMorphTargetStrokeChange::FMorphTargetStrokeChange(const FMeshVertexChange& Change)
+{
+	NumVertices = Change.Vertices.Num();
+
+	TArray<int32> Order;
+	Order.SetNumUninitialized(NumVertices);
+	FAxisAlignedBox3d Bounds = FAxisAlignedBox3d::Empty();
+	for (int32 k = 0; k < NumVertices; ++k)
+	{
+		Order[k] = k;
+		Bounds.Contain(Change.OldPositions[k]);
+		Bounds.Contain(Change.NewPositions[k]);
+	}
+	Order.Sort([&Change](const int32 A, const int32 B) { return Change.Vertices[A] < Change.Vertices[B]; });
+
+	// the step only has to resolve the moves, an unmoved stroke can use any step
+	QuantizationStep = FMathd::Max(Bounds.MaxDim() * RelativeQuantizationStep, FMathd::ZeroTolerance);
+	bQuantized = QuantizationStep <= MaxQuantizationStep;
+
+	EncodedVertexIDs.Reserve(NumVertices * 2);
+	if (bQuantized)
+	{
+		EncodedMoves.Reserve(NumVertices * 6);
+	}
+	else
+	{
+		OldPositions.Reserve(NumVertices);
+		NewPositions.Reserve(NumVertices);
+	}
+
+	int32 PreviousVertexID = 0;
+	for (const int32 k : Order)
+	{
+		const int32 VertexID = Change.Vertices[k];
+		WriteVarInt(EncodedVertexIDs, static_cast<uint64>(VertexID - PreviousVertexID));
+		PreviousVertexID = VertexID;
+
+		if (bQuantized)
+		{
+			const FVector3d Move = Change.NewPositions[k] - Change.OldPositions[k];
+			for (int32 j = 0; j < 3; ++j)
+			{
+				WriteVarInt(EncodedMoves, ZigZagEncode(FMath::RoundToInt64(Move[j] / QuantizationStep)));
+			}
+		}
+		else
+		{
+			OldPositions.Add(Change.OldPositions[k]);
+			NewPositions.Add(Change.NewPositions[k]);
+		}
+	}
+
+	EncodedVertexIDs.Shrink();
+	EncodedMoves.Shrink();
+}
+
+
+void FMorphTargetStrokeChange::Apply(UObject* Object)
+{
+	ApplyChange(Object, false);
+}
+
+
+void FMorphTargetStrokeChange::Revert(UObject* Object)
+{
+	ApplyChange(Object, true);
+}
+
+
+FString FMorphTargetStrokeChange::ToString() const
+{
+	return FString::Printf(TEXT("Morph Target Stroke Change (%d vertices, %s)"), NumVertices, bQuantized ? TEXT("quantized") : TEXT("lossless"));
+}
+
+
+void FMorphTargetStrokeChange::ApplyChange(UObject* Object, bool bRevert) const
+{
+	UDynamicMeshComponent* Component = Cast<UDynamicMeshComponent>(Object);
+	if (Component == nullptr)
+	{
+		return;
+	}
+
+	if (BeforeModify)
+	{
+		BeforeModify(bRevert);
+	}
+
+	// decoded against the current positions, the full change only lives until the component has applied it
+	FMeshVertexChange Change;
+	Component->ProcessMesh([&](const FDynamicMesh3& Mesh)
+	{
+		Decode(Mesh, bRevert, Change);
+	});
+	Component->ApplyChange(&Change, bRevert);
+}
+
+
+void FMorphTargetStrokeChange::Decode(const FDynamicMesh3& Mesh, bool bRevert, FMeshVertexChange& ChangeOut) const
+{
+	ChangeOut.Vertices.Reset(NumVertices);
+	ChangeOut.OldPositions.Reset(NumVertices);
+	ChangeOut.NewPositions.Reset(NumVertices);
+
+	int32 VertexOffset = 0, MoveOffset = 0;
+	int32 VertexID = 0;
+	for (int32 k = 0; k < NumVertices; ++k)
+	{
+		VertexID += static_cast<int32>(ReadVarInt(EncodedVertexIDs, VertexOffset));
+
+		FVector3d Move;
+		if (bQuantized)
+		{
+			// read even for a vertex that is skipped below, the moves of the following vertices come after it
+			for (int32 j = 0; j < 3; ++j)
+			{
+				Move[j] = static_cast<double>(ZigZagDecode(ReadVarInt(EncodedMoves, MoveOffset))) * QuantizationStep;
+			}
+		}
+
+		// the record only matches the mesh it was made on, a mesh that was replaced since may not have the vertex anymore
+		if (!ensure(Mesh.IsVertex(VertexID)))
+		{
+			continue;
+		}
+
+		ChangeOut.Vertices.Add(VertexID);
+		if (bQuantized)
+		{
+			// the mesh is at the new positions when reverting, and at the old ones when applying
+			const FVector3d Current = Mesh.GetVertex(VertexID);
+			ChangeOut.OldPositions.Add(bRevert ? Current - Move : Current);
+			ChangeOut.NewPositions.Add(bRevert ? Current : Current + Move);
+		}
+		else
+		{
+			ChangeOut.OldPositions.Add(OldPositions[k]);
+			ChangeOut.NewPositions.Add(NewPositions[k]);
+		}
+	}
+}
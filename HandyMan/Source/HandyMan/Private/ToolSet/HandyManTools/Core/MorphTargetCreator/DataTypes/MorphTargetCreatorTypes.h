@@ -3,6 +3,119 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "InteractiveToolChange.h"
 #include "UObject/Object.h"
 
+class FMeshVertexChange;
+namespace UE::Geometry { class FDynamicMesh3; }
 
+
+/* Set of mesh indices stored as one flag per index plus the list of indices that are set.
+ * Adding and resetting only touch the indices in the set, so it stays cheap over a whole stroke
+ */
+class HANDYMAN_API FMorphTargetIndexSet
+{
+public:
+	/** Sizes the flags for indices below MaxIndex, the current content is kept */
+	void Initialize(const int32 MaxIndex)
+	{
+		if (Flags.Num() < MaxIndex)
+		{
+			Flags.SetNum(MaxIndex, false);
+		}
+	}
+
+	/** Returns true if the index was not in the set yet */
+	bool Add(const int32 Index)
+	{
+		if (Index >= Flags.Num())
+		{
+			Flags.SetNum(Index + 1, false);
+		}
+		
+		FBitReference Flag = Flags[Index];
+		if (Flag)
+		{
+			return false;
+		}
+		
+		Flag = true;
+		Indices.Add(Index);
+		return true;
+	}
+
+	void Append(TConstArrayView<int32> InIndices)
+	{
+		for (const int32 Index : InIndices)
+		{
+			Add(Index);
+		}
+	}
+
+	bool Contains(const int32 Index) const
+	{
+		return Index < Flags.Num() && Flags[Index];
+	}
+
+	/** Clears the set, the flags keep their size */
+	void Reset()
+	{
+		for (const int32 Index : Indices)
+		{
+			Flags[Index] = false;
+		}
+		Indices.Reset();
+	}
+
+	int32 Num() const { return Indices.Num(); }
+	bool IsEmpty() const { return Indices.IsEmpty(); }
+
+	/** Indices in the order they were added */
+	const TArray<int32>& GetIndices() const { return Indices; }
+
+private:
+	TBitArray<> Flags;
+	TArray<int32> Indices;
+};
+
+
+/* Vertex change of one sculpt stroke, kept small while it sits in the undo buffer.
+ * Vertex IDs are sorted and delta-encoded, and only the move of each vertex is stored: Apply adds it to the
+ * current positions and Revert subtracts it. Moves are quantized to a step relative to the stroke bounds,
+ * strokes where that step would be too coarse keep full precision positions instead.
+ * Undo and redo land within half a step of the original positions, up to floating point rounding of the add and subtract
+ */
+class HANDYMAN_API FMorphTargetStrokeChange : public FToolCommandChange
+{
+public:
+	explicit FMorphTargetStrokeChange(const FMeshVertexChange& Change);
+
+	/** Called before the change is applied or reverted, with bRevert */
+	TUniqueFunction<void(bool)> BeforeModify;
+
+	virtual void Apply(UObject* Object) override;
+	virtual void Revert(UObject* Object) override;
+	virtual FString ToString() const override;
+
+	/** Quantization step as a fraction of the largest stroke bounds dimension */
+	static constexpr double RelativeQuantizationStep = 1.0 / 65536.0;
+	/** Strokes that would need a larger step are stored losslessly */
+	static constexpr double MaxQuantizationStep = 0.001;
+
+private:
+	void ApplyChange(UObject* Object, bool bRevert) const;
+	void Decode(const UE::Geometry::FDynamicMesh3& Mesh, bool bRevert, FMeshVertexChange& ChangeOut) const;
+
+	int32 NumVertices = 0;
+	// Gaps between the sorted vertex IDs, as variable length integers
+	TArray<uint8> EncodedVertexIDs;
+
+	// Three zigzag variable length integers per vertex, in units of QuantizationStep
+	bool bQuantized = false;
+	double QuantizationStep = 0.0;
+	TArray<uint8> EncodedMoves;
+
+	// Lossless fallback, in sorted vertex order
+	TArray<FVector3d> OldPositions;
+	TArray<FVector3d> NewPositions;
+};
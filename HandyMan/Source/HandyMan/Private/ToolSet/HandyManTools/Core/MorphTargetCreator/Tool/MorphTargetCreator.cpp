@@ -48,6 +48,37 @@ namespace
 #else
 	static EAsyncExecution VertexSculptToolAsyncExecTarget = EAsyncExecution::ThreadPool;
 #endif
+
+	// Normal elements touched by the triangles, or their vertices if the mesh has no normal overlay
+	static void CollectNormalsROI(const FDynamicMesh3* Mesh, const TArray<int32>& TriangleROI, FMorphTargetIndexSet& NormalsROIOut, bool& bIsOverlayElementsOut)
+	{
+		NormalsROIOut.Reset();
+		
+		const FDynamicMeshNormalOverlay* Normals = Mesh->HasAttributes() ? Mesh->Attributes()->PrimaryNormals() : nullptr;
+		bIsOverlayElementsOut = Normals != nullptr;
+		
+		NormalsROIOut.Initialize(Normals ? Normals->MaxElementID() : Mesh->MaxVertexID());
+		for (const int32 TriangleID : TriangleROI)
+		{
+			const FIndex3i Triangle = Normals ? Normals->GetTriangle(TriangleID) : Mesh->GetTriangle(TriangleID);
+			NormalsROIOut.Add(Triangle.A);
+			NormalsROIOut.Add(Triangle.B);
+			NormalsROIOut.Add(Triangle.C);
+		}
+	}
+
+	static void CollectROIVertices(const FDynamicMesh3* Mesh, const TArray<int32>& TriangleROI, FMorphTargetIndexSet& VerticesOut)
+	{
+		VerticesOut.Reset();
+		VerticesOut.Initialize(Mesh->MaxVertexID());
+		for (const int32 TriangleID : TriangleROI)
+		{
+			const FIndex3i Triangle = Mesh->GetTriangle(TriangleID);
+			VerticesOut.Add(Triangle.A);
+			VerticesOut.Add(Triangle.B);
+			VerticesOut.Add(Triangle.C);
+		}
+	}
 }
 
 
@@ -92,12 +123,11 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 		// If we have removed a mesh then we need to tell our tool to remove that dynamic mesh
 		if (ParentToolPtr->bHasToolStarted)
 		{
-			if (MorphTargets.Num() < ParentToolPtr->GetMorphTargetMeshMap().Num())
+			if (MorphTargets.Num() < ParentToolPtr->GetMorphTargetMeshNames().Num())
 			{
 				// Find the missing morph
 			
-				TArray<FName> CachedMorphs;
-				Meshes.GetKeys(CachedMorphs);
+				const TArray<FName> CachedMorphs = Meshes;
 
 				FName MorphToRemove = NAME_None;
 				for (int i = CachedMorphs.Num() - 1; i >= 0; --i)
@@ -109,7 +139,7 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 
 				// Tell the tool to remove the missing morph
 				ParentToolPtr->RemoveMorphTargetMesh(MorphToRemove);
-				Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+				Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 				return;
 			}
 		
@@ -117,7 +147,7 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 			if (!MorphTargets.Last().IsEqual(NAME_None))
 			{
 				ParentToolPtr->CreateMorphTargetMesh(MorphTargets.Last());
-				Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+				Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 				ParentToolPtr->TriggerToolStartUp();
 			}
 		}
@@ -138,15 +168,15 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 			// remove all morph because we are about to manually create new morph targets
 			ParentToolPtr->RemoveAllMorphTargetMeshes();
 			bWasEditingExitingMorph = false;
-			Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+			Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 		}
 		else if(!bWasEditingExitingMorph && bEditExistingMorph && MorphTargets.Num() > 0)
 		{
 			ParentToolPtr->RemoveAllMorphTargetMeshes();
-			Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+			Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 			MorphTargets.Empty();
 			bWasEditingExitingMorph = true;
-			Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+			Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 		}
 	}
 
@@ -157,7 +187,7 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 			if (bOverrideExistingMorph)
 			{
 				ParentToolPtr->CloneMorph(MorphTargetToEdit, NAME_None);
-				Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+				Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 			}
 		}
 	}
@@ -168,7 +198,7 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 		{
 			ParentToolPtr->RemoveAllMorphTargetMeshes();
 			ParentToolPtr->CloneMorph(MorphTargetToEdit, NewMorphTargetName);
-			Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+			Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 		}
 	}
 
@@ -177,7 +207,7 @@ TArray<FString> UMorphTargetProperties::GetMorphTargetNames() const
 		if (!bOverrideExistingMorph && MorphTargetToEdit.IsValid() && NewMorphTargetName.IsValid())
 		{
 			ParentToolPtr->CloneMorph(MorphTargetToEdit, NewMorphTargetName);
-			Meshes = ParentToolPtr->GetMorphTargetMeshMap();
+			Meshes = ParentToolPtr->GetMorphTargetMeshNames();
 		}
 	}
 
@@ -686,6 +716,8 @@ void UMorphTargetCreator::Setup()
 
 void UMorphTargetCreator::Shutdown(EToolShutdownType ShutdownType)
 {
+	FinishPendingStampNormals();
+
 	if (DynamicMeshComponent != nullptr)
 	{
 		DynamicMeshComponent->OnMeshChanged.Remove(OnDynamicMeshComponentChangedHandle);
@@ -741,14 +773,14 @@ FBox UMorphTargetCreator::GetWorldSpaceFocusBox()
 	return Super::GetWorldSpaceFocusBox();
 }
 
-TMap<FName, TObjectPtr<UDynamicMesh>> UMorphTargetCreator::GetMorphTargetMeshMap() const
+TArray<FName> UMorphTargetCreator::GetMorphTargetMeshNames() const
 {
 	if (TargetActor)
 	{
-		return TargetActor->GetMorphTargetMeshMap();
+		return TargetActor->GetMorphTargetMeshNames();
 	}
 
-	return TMap<FName, TObjectPtr<UDynamicMesh>>();
+	return TArray<FName>();
 }
 
 void UMorphTargetCreator::RemoveMorphTargetMesh(const FName MorphTargetMeshName)
@@ -926,6 +958,7 @@ void UMorphTargetCreator::OnBeginStroke(const FRay& WorldRay)
 	UseBrushOp->BeginStroke(GetSculptMesh(), LastStamp, VertexROI);
 
 	AccumulatedTriangleROI.Reset();
+	AccumulatedTriangleROI.Initialize(GetSculptMesh()->MaxTriangleID());
 
 	// begin change here? or wait for first stamp?
 	BeginChange();
@@ -939,6 +972,9 @@ void UMorphTargetCreator::OnEndStroke()
 
 	GetActiveBrushOp()->EndStroke(GetSculptMesh(), LastStamp, VertexROI);
 
+	// last stamp of the stroke has to be complete and visible
+	FinishPendingStampNormals();
+
 	// close change record
 	EndChange();
 }
@@ -950,6 +986,8 @@ void UMorphTargetCreator::OnCancelStroke()
 	
 	GetActiveBrushOp()->CancelStroke();
 
+	FinishPendingStampNormals();
+
 	delete ActiveVertexChange;
 	ActiveVertexChange = nullptr;
 }
@@ -1242,6 +1280,9 @@ TFuture<void> UMorphTargetCreator::ApplyStamp()
 	// can discard alpha now
 	CurrentStamp.StampAlphaFunc = nullptr;
 
+	// mesh positions are written from here on, the previous stamp's normals may still be reading them
+	WaitForOverlappingStampNormals();
+
 	// if we are applying symmetry, we need to update the on-plane positions as they
 	// will not be in the SymmetricVertexROI
 	if (bApplySymmetry)
@@ -1434,12 +1475,12 @@ void UMorphTargetCreator::UpdateHoverStamp(const FFrame3d& StampFrameWorld)
 
 bool UMorphTargetCreator::CanAccept() const
 {
-	return TargetActor != nullptr && TargetActor->GetMorphTargetMeshMap().Num() > 0;
+	return TargetActor != nullptr && TargetActor->GetNumMorphTargetMeshes() > 0;
 }
 
 bool UMorphTargetCreator::HitTest(const FRay& Ray, FHitResult& OutHit)
 {
-	return TargetActor && TargetActor->GetMorphTargetMeshMap().Num() > 0 && Super::HitTest(Ray, OutHit);
+	return TargetActor && TargetActor->GetNumMorphTargetMeshes() > 0 && Super::HitTest(Ray, OutHit);
 }
 
 FInputRayHit UMorphTargetCreator::TestIfCanBeginClickDrag_Implementation(FInputDeviceRay ClickPos, const FScriptableToolModifierStates& Modifiers)
@@ -1546,7 +1587,7 @@ void UMorphTargetCreator::OnTick(float DeltaTime)
 		WaitForPendingUndoRedo();
 
 		// post rendering update
-		DynamicMeshComponent->FastNotifyTriangleVerticesUpdated(AccumulatedTriangleROI,
+		DynamicMeshComponent->FastNotifyTriangleVerticesUpdated(AccumulatedTriangleROI.GetIndices(),
 			EMeshRenderAttributeFlags::Positions | EMeshRenderAttributeFlags::VertexNormals);
 		GetToolManager()->PostInvalidation();
 
@@ -1571,11 +1612,13 @@ void UMorphTargetCreator::OnTick(float DeltaTime)
 		// update brush position
 		if (UpdateStampPosition(GetPendingStampRayWorld()) == false)
 		{
+			FinishPendingStampNormals();
 			return;
 		}
 		UpdateStampPendingState();
 		if (IsStampPending() == false)
 		{
+			FinishPendingStampNormals();
 			return;
 		}
 
@@ -1585,26 +1628,20 @@ void UMorphTargetCreator::OnTick(float DeltaTime)
 		// update sculpt ROI
 		UpdateROI(CurrentStamp.LocalFrame.Origin);
 
-		// Append updated ROI to modified region (async). For some reason this is very expensive,
-		// maybe because of TSet? but we have a lot of time to do it.
+		// Append updated ROI to modified region (async). Only touches the ROI, so it does not grow with the stroke
 		TFuture<void> AccumulateROI = Async(VertexSculptToolAsyncExecTarget, [this]()
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_AccumROI);
-			for (int32 tid : TriangleROIArray)
-			{
-				AccumulatedTriangleROI.Add(tid);
-			}
+			AccumulatedTriangleROI.Append(TriangleROIArray);
 		});
 
-		// Start precomputing the normals ROI. This is currently the most expensive single thing we do next
-		// to Octree re-insertion, despite it being almost trivial. Why?!?
-		bool bUsingOverlayNormalsOut = false;
-		TFuture<void> NormalsROI = Async(VertexSculptToolAsyncExecTarget, [Mesh, &bUsingOverlayNormalsOut, this]()
+		// Start precomputing the normals ROI, only the elements of the ROI triangles are touched.
+		// The previous stamp's normals may still be running, they use the pending sets
+		TFuture<void> NormalsROI = Async(VertexSculptToolAsyncExecTarget, [Mesh, this]()
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_NormalsROI);
-
-			//HandyMan::SculptUtil::PrecalculateNormalsROI(Mesh, TriangleROIArray, NormalsROIBuilder, bUsingOverlayNormals, false);
-			HandyMan::SculptUtil::PrecalculateNormalsROI(Mesh, TriangleROIArray, NormalsFlags, bUsingOverlayNormalsOut, false);
+			CollectNormalsROI(Mesh, TriangleROIArray, NormalsROISet, bNormalsROIIsOverlay);
+			CollectROIVertices(Mesh, TriangleROIArray, NormalsROIVertices);
 		});
 
 		// NOTE: you might try to speculatively do the octree remove here, to save doing it later on Reinsert().
@@ -1628,31 +1665,27 @@ void UMorphTargetCreator::OnTick(float DeltaTime)
 		//	Octree.ReinsertTriangles(TriangleROIArray);
 		//});
 
-		// TODO: first step of RecalculateROINormals() is to convert TriangleROI into vertex or element ROI.
-		// We can do this while we are computing stamp!
-
-		// precompute dynamic mesh update info
-		TArray<int32> RenderUpdateSets; FAxisAlignedBox3d RenderUpdateBounds;
-		TFuture<bool> RenderUpdatePrecompute = DynamicMeshComponent->FastNotifyTriangleVerticesUpdated_TryPrecompute(
-				TriangleROIArray, RenderUpdateSets, RenderUpdateBounds);
+		// previous stamp has to be retired before its sets are reused, this is usually a no-op by now
+		FinishPendingStampNormals();
 
-		// recalculate normals. This has to complete before we can update component
-		// (in fact we could do it per-chunk...)
+		// recalculate normals and precompute the render update. These run until the next stamp, which only
+		// waits for them before writing positions if the ROIs touch, and the component is updated after that
 		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_RecalcNormals);
+			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_LaunchNormals);
 			NormalsROI.Wait();
-			HandyMan::SculptUtil::RecalculateROINormals(Mesh, NormalsFlags, bUsingOverlayNormalsOut);
-			//HandyMan::SculptUtil::RecalculateROINormals(Mesh, NormalsROIBuilder.Indices(), bUsingOverlayNormals);
-		}
+			Swap(NormalsROISet, PendingNormalsROISet);
+			Swap(NormalsROIVertices, PendingNormalsVertices);
+			PendingStampTriangleROI = TriangleROIArray;
 
-		{
-			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_UpdateMesh);
-			RenderUpdatePrecompute.Wait();
-			DynamicMeshComponent->FastNotifyTriangleVerticesUpdated_ApplyPrecompute(TriangleROIArray,
-				EMeshRenderAttributeFlags::Positions | EMeshRenderAttributeFlags::VertexNormals,
-				RenderUpdatePrecompute, RenderUpdateSets, RenderUpdateBounds);
+			PendingRenderUpdatePrecompute = DynamicMeshComponent->FastNotifyTriangleVerticesUpdated_TryPrecompute(
+				PendingStampTriangleROI, PendingRenderUpdateSets, PendingRenderUpdateBounds);
 
-			GetToolManager()->PostInvalidation();
+			StampNormalsFuture = Async(VertexSculptToolAsyncExecTarget, [Mesh, this, bIsOverlay = bNormalsROIIsOverlay]()
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Tick_RecalcNormals);
+				HandyMan::SculptUtil::RecalculateROINormals(Mesh, PendingNormalsROISet.GetIndices(), bIsOverlay);
+			});
+			bStampNormalsPending = true;
 		}
 
 		// we don't really need to wait for these to happen to end Tick()...
@@ -1665,7 +1698,7 @@ void UMorphTargetCreator::OnTick(float DeltaTime)
 		check(InStroke() == false);
 
 		// this spawns futures that we could allow to run while other things happen...
-		UpdateBaseMesh(&AccumulatedTriangleROI);
+		UpdateBaseMesh(&AccumulatedTriangleROI.GetIndices());
 		AccumulatedTriangleROI.Reset();
 
 		bTargetDirty = false;
@@ -1680,13 +1713,53 @@ void UMorphTargetCreator::WaitForPendingStampUpdate()
 	if (bStampUpdatePending)
 	{
 		StampUpdateOctreeFuture.Wait();
-		bStampUpdatePending = true;
+		bStampUpdatePending = false;
+	}
+}
+
+
+void UMorphTargetCreator::WaitForOverlappingStampNormals()
+{
+	if (bStampNormalsPending == false || StampNormalsFuture.IsReady())
+	{
+		return;
+	}
+
+	// The ROI triangles contain the one-rings of all vertices this stamp moves, so only a triangle
+	// sharing a vertex with the previous ROI can change a normal that is still being computed
+	TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_WaitForOverlappingNormals);
+	const FDynamicMesh3* Mesh = GetSculptMesh();
+	for (const int32 TriangleID : TriangleROIArray)
+	{
+		const FIndex3i Triangle = Mesh->GetTriangle(TriangleID);
+		if (PendingNormalsVertices.Contains(Triangle.A) || PendingNormalsVertices.Contains(Triangle.B) || PendingNormalsVertices.Contains(Triangle.C))
+		{
+			StampNormalsFuture.Wait();
+			return;
+		}
+	}
+}
+
+
+void UMorphTargetCreator::FinishPendingStampNormals()
+{
+	if (bStampNormalsPending)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_FinishPendingNormals);
+		StampNormalsFuture.Wait();
+		PendingRenderUpdatePrecompute.Wait();
+		DynamicMeshComponent->FastNotifyTriangleVerticesUpdated_ApplyPrecompute(PendingStampTriangleROI,
+			EMeshRenderAttributeFlags::Positions | EMeshRenderAttributeFlags::VertexNormals,
+			PendingRenderUpdatePrecompute, PendingRenderUpdateSets, PendingRenderUpdateBounds);
+
+		GetToolManager()->PostInvalidation();
+		bStampNormalsPending = false;
 	}
 }
 
 
 
-void UMorphTargetCreator::UpdateBaseMesh(const TSet<int32>* TriangleSet)
+void UMorphTargetCreator::UpdateBaseMesh(const TArray<int32>* TriangleSet)
 {
 	if (SculptProperties != nullptr)
 	{
@@ -1710,19 +1783,17 @@ void UMorphTargetCreator::UpdateBaseMesh(const TSet<int32>* TriangleSet)
 	}
 	else
 	{
-		BaseMeshIndexBuffer.Reset();
 		for ( int32 tid : *TriangleSet)
 		{ 
 			FIndex3i Tri = BaseMesh.GetTriangle(tid);
 			BaseMesh.SetVertex(Tri.A, SculptMesh->GetVertex(Tri.A));
 			BaseMesh.SetVertex(Tri.B, SculptMesh->GetVertex(Tri.B));
 			BaseMesh.SetVertex(Tri.C, SculptMesh->GetVertex(Tri.C));
-			BaseMeshIndexBuffer.Add(tid);
 		}
-		auto UpdateBaseNormals = Async(VertexSculptToolAsyncExecTarget, [this]()
+		auto UpdateBaseNormals = Async(VertexSculptToolAsyncExecTarget, [TriangleSet, this]()
 		{
 			TRACE_CPUPROFILER_EVENT_SCOPE(UMorphTargetCreator_Target_UpdateBaseNormals);
-			FMeshNormals::QuickComputeVertexNormalsForTriangles(BaseMesh, BaseMeshIndexBuffer);
+			FMeshNormals::QuickComputeVertexNormalsForTriangles(BaseMesh, *TriangleSet);
 		});
 		auto ReinsertTriangles = Async(VertexSculptToolAsyncExecTarget, [TriangleSet, this]()
 		{
@@ -1857,8 +1928,8 @@ void UMorphTargetCreator::EndChange()
 {
 	check(ActiveVertexChange);
 
-	TUniquePtr<TWrappedToolCommandChange<FMeshVertexChange>> NewChange = MakeUnique<TWrappedToolCommandChange<FMeshVertexChange>>();
-	NewChange->WrappedChange = MoveTemp(ActiveVertexChange->Change);
+	// stored compressed, strokes on dense meshes touch a lot of vertices
+	TUniquePtr<FMorphTargetStrokeChange> NewChange = MakeUnique<FMorphTargetStrokeChange>(*ActiveVertexChange->Change);
 	NewChange->BeforeModify = [this](bool bRevert)
 	{
 		this->WaitForPendingUndoRedo();
@@ -1894,6 +1965,7 @@ void UMorphTargetCreator::OnDynamicMeshComponentChanged(UDynamicMeshComponent* C
 {
 	// have to wait for any outstanding stamp update to finish...
 	WaitForPendingStampUpdate();
+	FinishPendingStampNormals();
 	// wait for previous Undo to finish (possibly never hit because the change records do it?)
 	WaitForPendingUndoRedo();
 
@@ -1901,26 +1973,31 @@ void UMorphTargetCreator::OnDynamicMeshComponentChanged(UDynamicMeshComponent* C
 
 	// figure out the set of modified triangles
 	AccumulatedTriangleROI.Reset();
-	UE::Geometry::VertexToTriangleOneRing(Mesh, Change->Vertices, AccumulatedTriangleROI);
+	AccumulatedTriangleROI.Initialize(Mesh->MaxTriangleID());
+	for (const int32 VertexID : Change->Vertices)
+	{
+		Mesh->EnumerateVertexTriangles(VertexID, [this](int32 TriangleID) { AccumulatedTriangleROI.Add(TriangleID); });
+	}
 
 	// start the normal recomputation
 	UndoNormalsFuture = Async(VertexSculptToolAsyncExecTarget, [this, Mesh]()
 	{
-		HandyMan::SculptUtil::RecalculateROINormals(Mesh, AccumulatedTriangleROI, NormalsROIBuilder);
+		CollectNormalsROI(Mesh, AccumulatedTriangleROI.GetIndices(), NormalsROISet, bNormalsROIIsOverlay);
+		HandyMan::SculptUtil::RecalculateROINormals(Mesh, NormalsROISet.GetIndices(), bNormalsROIIsOverlay);
 		return true;
 	});
 
 	// start the octree update
 	UndoUpdateOctreeFuture = Async(VertexSculptToolAsyncExecTarget, [this, Mesh]()
 	{
-		Octree.ReinsertTriangles(AccumulatedTriangleROI);
+		Octree.ReinsertTriangles(AccumulatedTriangleROI.GetIndices());
 		return true;
 	});
 
 	// start the base mesh update
 	UndoUpdateBaseMeshFuture = Async(VertexSculptToolAsyncExecTarget, [this, Mesh]()
 	{
-		UpdateBaseMesh(&AccumulatedTriangleROI);
+		UpdateBaseMesh(&AccumulatedTriangleROI.GetIndices());
 		return true;
 	});
 
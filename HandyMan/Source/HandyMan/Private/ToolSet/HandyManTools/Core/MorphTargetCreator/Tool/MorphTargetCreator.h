@@ -9,6 +9,7 @@
 #include "Image/ImageBuilder.h"
 #include "Parameterization/MeshPlanarSymmetry.h"
 #include "Polygroups/PolygroupSet.h"
+#include "ToolSet/HandyManTools/Core/MorphTargetCreator/DataTypes/MorphTargetCreatorTypes.h"
 #include "ToolSet/HandyManBaseClasses/HandyManClickDragTool.h"
 #include "ToolSet/HandyManTools/Core/SculptTool/DataTypes/HandyManSculptingTypes.h"
 #include "ToolSet/HandyManTools/Core/SculptTool/Tool/HandyManSculptTool.h"
@@ -48,7 +49,7 @@ public:
 	TArray<FName> MorphTargets;
 	
 	UPROPERTY(VisibleAnywhere, Category = Morphs)
-	TMap<FName, TObjectPtr<UDynamicMesh>> Meshes;
+	TArray<FName> Meshes;
 
 
 	UFUNCTION()
@@ -223,7 +224,7 @@ private:
 
 public:
 
-	TMap<FName, TObjectPtr<UDynamicMesh>> GetMorphTargetMeshMap() const;
+	TArray<FName> GetMorphTargetMeshNames() const;
 	void RemoveMorphTargetMesh(FName MorphTargetMeshName);
 	FName CurrentMorphEdit = NAME_None;
 	void RemoveAllMorphTargetMeshes(const bool bShouldRestoreLastMorph = false);
@@ -300,7 +301,8 @@ protected:
 
 	int32 InitialStrokeTriangleID = -1;
 
-	TSet<int32> AccumulatedTriangleROI;
+	// Triangles modified by the current stroke, or by the last undo/redo
+	FMorphTargetIndexSet AccumulatedTriangleROI;
 	bool bUndoUpdatePending = false;
 	TFuture<bool> UndoNormalsFuture;
 	TFuture<bool> UndoUpdateOctreeFuture;
@@ -322,10 +324,25 @@ protected:
 	TArray<int> TriangleROIArray;
 	void UpdateROI(const FVector3d& BrushPos);
 
-	UE::Geometry::FUniqueIndexSet NormalsROIBuilder;
-	TArray<std::atomic<bool>> NormalsFlags;		// set of per-vertex or per-element-id flags that indicate
-												// whether normal needs recompute. Fast to do it this way
-												// than to use a TSet or UniqueIndexSet...
+	// Overlay normal elements, or vertices without an overlay, whose normal needs recompute.
+	// Filled and cleared per stamp in O(ROI), unlike per-element flags that have to be scanned whole
+	FMorphTargetIndexSet NormalsROISet;
+	bool bNormalsROIIsOverlay = false;
+	// Vertices of the ROI triangles, their normals read the positions of every triangle around them
+	FMorphTargetIndexSet NormalsROIVertices;
+
+	// The last stamp's normals and render update finish on workers while the next stamp runs its range query and
+	// computes new positions. The next stamp only waits for them before writing positions if its ROI touches theirs
+	FMorphTargetIndexSet PendingNormalsROISet;
+	FMorphTargetIndexSet PendingNormalsVertices;
+	TArray<int> PendingStampTriangleROI;
+	TArray<int32> PendingRenderUpdateSets;
+	UE::Geometry::FAxisAlignedBox3d PendingRenderUpdateBounds;
+	TFuture<bool> PendingRenderUpdatePrecompute;
+	TFuture<void> StampNormalsFuture;
+	bool bStampNormalsPending = false;
+	void WaitForOverlappingStampNormals();
+	void FinishPendingStampNormals();
 
 	bool bTargetDirty;
 
@@ -338,9 +355,8 @@ protected:
 
 	FDynamicMesh3 BaseMesh;
 	UE::Geometry::FDynamicMeshOctree3 BaseMeshSpatial;
-	TArray<int32> BaseMeshIndexBuffer;
 	bool bCachedFreezeTarget = false;
-	void UpdateBaseMesh(const TSet<int32>* TriangleROI = nullptr);
+	void UpdateBaseMesh(const TArray<int32>* TriangleROI = nullptr);
 	bool GetBaseMeshNearest(int32 VertexID, const FVector3d& Position, double SearchRadius, FVector3d& TargetPosOut, FVector3d& TargetNormalOut);
 	TFunction<bool(int32, const FVector3d&, double MaxDist, FVector3d&, FVector3d&)> BaseMeshQueryFunc;
 
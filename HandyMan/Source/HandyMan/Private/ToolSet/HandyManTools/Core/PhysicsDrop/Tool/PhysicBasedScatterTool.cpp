@@ -16,19 +16,22 @@
 #include "ToolTargetManager.h"
 #include "UnrealEdGlobals.h"
 #include "BaseBehaviors/MouseHoverBehavior.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Components/InstancedStaticMeshComponent.h"
 #include "ConversionUtils/SceneComponentToDynamicMesh.h"
 #include "DynamicMesh/DynamicMeshAttributeSet.h"
 #include "Editor/UnrealEdEngine.h"
+#include "EngineUtils.h"
 #include "Engine/StaticMeshActor.h"
 #include "GeometryCollection/GeometryCollectionActor.h"
 #include "GeometryScript/MeshAssetFunctions.h"
 #include "GeometryScript/MeshBasicEditFunctions.h"
 #include "GeometryScript/MeshModelingFunctions.h"
-#include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "MeshMerge/MeshInstancingSettings.h"
 #include "Physics/ComponentCollisionUtil.h"
 #include "Physics/Experimental/PhysScene_Chaos.h"
+#include "PhysicsEngine/BodySetup.h"
 #include "PropertySets/OnAcceptProperties.h"
 #include "Selection/ToolSelectionUtil.h"
 #include "TargetInterfaces/DynamicMeshCommitter.h"
@@ -133,14 +136,11 @@ void UPhysicBasedScatterTool::OnLevelActorsDeleted(AActor* InActor)
 	{
 		LastSelectedActors.Remove(InActor);
 	}
-	if (LevelActors.Contains(InActor))
-	{
-		LevelActors.Remove(InActor);
-	}
 
 	auto Prims = GetPrimitives(InActor);
 	for (auto& Prim : Prims)
 	{
+		SimulatedPrimitives.Remove(Prim);
 		if (Mobilities.Contains(Prim))
 		{
 			Mobilities.Remove(Prim);
@@ -175,6 +175,7 @@ void UPhysicBasedScatterTool::Setup()
 	OnLevelActorsAddedHandle = GEngine->OnLevelActorAdded().AddUObject(this, &ThisClass::OnLevelActorsAdded);
 	OnLevelActorsDeletedHandle = GEngine->OnLevelActorDeleted().AddUObject(this, &ThisClass::OnLevelActorsDeleted);
 	OnPreBeginPieHandle = FEditorDelegates::PreBeginPIE.AddUObject(this, &ThisClass::OnPreBeginPie);
+	OnSelectionChangedHandle = USelection::SelectionChangedEvent.AddUObject(this, &ThisClass::OnSelectionChanged);
 	
 	CreateBrush();
 
@@ -273,6 +274,10 @@ void UPhysicBasedScatterTool::OnClickDrag(const FInputDeviceRay& DragPos)
 			{
 				GetWorld()->DestroyActor(Hit.GetActor());
 			}
+			else if (UInstancedStaticMeshComponent* HitInstances = Cast<UInstancedStaticMeshComponent>(Hit.GetComponent()))
+			{
+				RemoveSimulatedInstance(HitInstances, Hit.Item);
+			}
 		}
 		else
 		{
@@ -284,20 +289,27 @@ void UPhysicBasedScatterTool::OnClickDrag(const FInputDeviceRay& DragPos)
 				{
 					LastSpawnedPosition = GetPosition();
 
-					FActorSpawnParameters Params = FActorSpawnParameters();
-					FString name = FString::Format(TEXT("Actor_{0}"), { ReferenceMesh->GetFName().ToString() });
-					FName fname = MakeUniqueObjectName(nullptr, AStaticMeshActor::StaticClass(), FName(*name));
-					Params.Name = fname;
-					Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+					if (PropertySet->IsUsingInstancedSimulation())
+					{
+						AddSimulatedInstance(ReferenceMesh, FTransform(Rotation, GetPosition(), PropertySet->GetScaleRandom()));
+					}
+					else
+					{
+						FActorSpawnParameters Params = FActorSpawnParameters();
+						FString name = FString::Format(TEXT("Actor_{0}"), { ReferenceMesh->GetFName().ToString() });
+						FName fname = MakeUniqueObjectName(nullptr, AStaticMeshActor::StaticClass(), FName(*name));
+						Params.Name = fname;
+						Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
 
-					AStaticMeshActor* actor = GetWorld()->SpawnActor<AStaticMeshActor>(GetPosition(), Rotation, Params);
+						AStaticMeshActor* actor = GetWorld()->SpawnActor<AStaticMeshActor>(GetPosition(), Rotation, Params);
 
-					actor->SetActorLabel(fname.ToString());
-					actor->SetActorScale3D(PropertySet->GetScaleRandom());
-					LastSpawnedActors.Add(actor);
-					actor->GetStaticMeshComponent()->SetStaticMesh(ReferenceMesh);
+						actor->SetActorLabel(fname.ToString());
+						actor->SetActorScale3D(PropertySet->GetScaleRandom());
+						LastSpawnedActors.Add(actor);
+						actor->GetStaticMeshComponent()->SetStaticMesh(ReferenceMesh);
 
-					UpdatePhysics(actor, PropertySet->IsEnableGravity());
+						UpdatePhysics(actor, PropertySet->IsEnableGravity());
+					}
 					PropertySet->SetRandomMesh();
 				}
 			}
@@ -322,6 +334,10 @@ bool UPhysicBasedScatterTool::Trace(FHitResult& OutHit, const FInputDeviceRay& D
 	if (!IsCtrlDown())
 	{
 		Params.AddIgnoredActors(LastSpawnedActors);
+		if (InstanceProxyActor)
+		{
+			Params.AddIgnoredActor(InstanceProxyActor);
+		}
 	}
 
 	bool bBeenHit = GetWorld()->LineTraceSingleByChannel(
@@ -346,6 +362,14 @@ void UPhysicBasedScatterTool::OnPreBeginPie(bool InStarted)
 {
 }
 
+void UPhysicBasedScatterTool::OnSelectionChanged(UObject* InSelection)
+{
+	if (InSelection == GEditor->GetSelectedActors())
+	{
+		ActorSelectionChangeNotify();
+	}
+}
+
 
 void UPhysicBasedScatterTool::OnPressedFunc(FInputDeviceRay ClickPos,FScriptableToolModifierStates Modifiers, EScriptableToolMouseButton MouseButton)
 {
@@ -387,9 +411,8 @@ void UPhysicBasedScatterTool::ActorSelectionChangeNotify()
 	{
 		if (PropertySet->IsSelectingPlacedActors())
 		{
-			TArray<AActor*> Actors;
-			UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), Actors);
-			for (auto& Actor : Actors)
+			// Only the selection can hold actors we have to deselect, no need to look at the rest of the level
+			for (auto& Actor : GetSelectedActors())
 			{
 				if (!SpawnedActors.Contains(Actor))
 				{
@@ -499,68 +522,12 @@ void UPhysicBasedScatterTool::OnTick(float DeltaTime)
 		if (PropertySet->GetLayoutMode() == ELayoutMode::Transform ||
 			PropertySet->GetLayoutMode() == ELayoutMode::Paint)
 		{
-			TArray<AActor*> Actors = GetSelectedActors();
 			Solver->StartingSceneSimulation();
-			if (Actors.Num() > 0)
+			if (PropertySet->IsDamplingVelocity())
 			{
-				for (int i = 0; i < Actors.Num(); ++i)
-				{
-					AActor* SelectedActor =  Actors[i];
-					if (!SelectedActor){continue;}
-
-					bool DampVelocity = PropertySet->IsDamplingVelocity();
-					if (!PropertySet->IsDamplingVelocity())
-					{
-						//DampVelocity = GetCurrentWidgetAxis() != EAxisList::None && GetWidgetLocation() == SelectedActor->GetActorLocation();
-					}
-					if (DampVelocity)
-					{
-						TArray<UPrimitiveComponent*> Prims = GetPrimitives(SelectedActor);
-						for (auto& Prim : Prims)
-						{
-							Prim->SetPhysicsLinearVelocity(FVector::ZeroVector);
-							Prim->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-						}
-					}
-				}
-
-				TArray<AActor*> TempActors;
-				LevelActors = TempActors;
-				UGameplayStatics::GetAllActorsOfClass(World, AActor::StaticClass(), TempActors);
-				if (LevelActors.Num() > 0)
-				{
-					for (int i = 0; i < LevelActors.Num(); ++i)
-					{
-						AActor* LevelActor = LevelActors[i];
-						if (!LevelActor) { continue;}
-						
-						if (AGeometryCollectionActor* CollectionActor = Cast<AGeometryCollectionActor>(LevelActor))
-						{
-							auto CollectionComponent = CollectionActor->GetGeometryCollectionComponent();
-						}
-						else
-						{
-
-							bool DampVelocity = PropertySet->IsDamplingVelocity();
-							if (!PropertySet->IsDamplingVelocity())
-							{
-								// TODO : I think this has something to do with checking if the gizmo and the actor are in the same location
-								//DampVelocity = GetCurrentWidgetAxis() != EAxisList::None && GetWidgetLocation() == LevelActor->GetActorLocation();
-							}
-
-							if (DampVelocity)
-							{
-								auto Prims = GetPrimitives(LevelActor);
-								for (auto& Prim : Prims)
-								{
-									Prim->SetPhysicsLinearVelocity(FVector::ZeroVector);
-									Prim->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
-								}
-							}
-						}
-					}
-				}
+				DampSimulatedPrimitives();
 			}
+			UpdateSimulatedInstances(PropertySet->IsDamplingVelocity());
 			Solver->AdvanceAndDispatch_External(DeltaTime);
 		}
 
@@ -578,9 +545,17 @@ void UPhysicBasedScatterTool::Shutdown(EToolShutdownType ShutdownType)
 	GEngine->OnLevelActorAdded().Remove(OnLevelActorsAddedHandle);
 	GEngine->OnLevelActorDeleted().Remove(OnLevelActorsDeletedHandle);
 	FEditorDelegates::PreBeginPIE.Remove(OnPreBeginPieHandle);
+	USelection::SelectionChangedEvent.Remove(OnSelectionChangedHandle);
 	
 	GetWorld()->FinishPhysicsSim();
 
+	// Instanced drops never become actors, so they can't go through the targets below
+	if (ShutdownType == EToolShutdownType::Accept)
+	{
+		BakeSimulatedInstances();
+	}
+	ReleaseSimulatedInstances();
+
 	TArray<UPrimitiveComponent*> SpawnedComponents = GetSpawnedComponents();
 	
 	// Set the actors as targets
@@ -616,7 +591,7 @@ void UPhysicBasedScatterTool::Shutdown(EToolShutdownType ShutdownType)
 	Mobilities.Reset();
 	Gravities.Reset();
 	Physics.Reset();
-	LevelActors.Reset();
+	SimulatedPrimitives.Reset();
 	LastSpawnedActors.Reset();
 	SpawnedActors.Reset();
 	Brush->UnregisterComponent();
@@ -630,7 +605,7 @@ void UPhysicBasedScatterTool::UpdateAcceptWarnings(EAcceptWarning Warning)
 
 bool UPhysicBasedScatterTool::CanAccept() const
 {
-	return Super::CanAccept() && SpawnedActors.Num() > 0;
+	return Super::CanAccept() && (SpawnedActors.Num() > 0 || GetNumSimulatedInstances() > 0);
 }
 
 void UPhysicBasedScatterTool::HandleAccept()
@@ -1092,7 +1067,10 @@ void UPhysicBasedScatterTool::DestroyActors(bool InSelected)
 	for (auto& Actor : Actors)
 	{
 		SpawnedActors.Remove(Actor);
-		LevelActors.Remove(Actor);
+		for (auto& Prim : GetPrimitives(Actor))
+		{
+			SimulatedPrimitives.Remove(Prim);
+		}
 		Actor->Destroy();
 	}
 }
@@ -1187,7 +1165,7 @@ void UPhysicBasedScatterTool::UpdatePhysics(AActor* InActor, bool bInEnableGravi
 		Prim->SetMobility(EComponentMobility::Movable);
 		Prim->SetEnableGravity(bInEnableGravity);
 		Prim->SetSimulatePhysics(bSimulatePhysic);
-
+		UpdateSimulatedPrimitive(Prim);
 	}
 }
 
@@ -1236,53 +1214,262 @@ void UPhysicBasedScatterTool::SelectPlacedActors(UStaticMesh* InStaticMesh)
 	}
 }
 
-void UPhysicBasedScatterTool::AddSelectedActor(AActor* InActor)
+void UPhysicBasedScatterTool::AddSimulatedInstance(UStaticMesh* InStaticMesh, const FTransform& InTransform)
 {
-	OnLevelActorsAdded(InActor);
+	UBodySetup* BodySetup = InStaticMesh ? InStaticMesh->GetBodySetup() : nullptr;
+	UInstancedStaticMeshComponent* InstancedComponent = GetOrCreateInstancedComponent(InStaticMesh);
+	if (!BodySetup || !InstancedComponent)
+	{
+		return;
+	}
+
+	const int32 InstanceIndex = InstancedComponent->AddInstance(InTransform, true);
+
+	// The component itself has no collision, the body carries it and reports the instance index in its hits
+	TUniquePtr<FBodyInstance> Body = MakeUnique<FBodyInstance>();
+	Body->SetCollisionProfileName(UCollisionProfile::PhysicsActor_ProfileName);
+	Body->SetInstanceSimulatePhysics(bSimulatePhysic);
+	Body->SetEnableGravity(PropertySet->IsEnableGravity());
+	Body->InstanceBodyIndex = InstanceIndex;
+	Body->InitBody(BodySetup, InTransform, InstancedComponent, GetWorld()->GetPhysicsScene());
+
+	InstanceBodies.FindOrAdd(InstancedComponent).Add(MoveTemp(Body));
 }
 
-void UPhysicBasedScatterTool::CachePhysics()
+void UPhysicBasedScatterTool::RemoveSimulatedInstance(UInstancedStaticMeshComponent* InComponent, int32 InInstanceIndex)
+{
+	TArray<TUniquePtr<FBodyInstance>>* Bodies = InstanceBodies.Find(InComponent);
+	if (!Bodies || !Bodies->IsValidIndex(InInstanceIndex))
+	{
+		return;
+	}
+
+	(*Bodies)[InInstanceIndex]->TermBody();
+	Bodies->RemoveAt(InInstanceIndex);
+	InComponent->RemoveInstance(InInstanceIndex);
+
+	// Removing an instance shifts the ones after it down, keep the bodies pointing at their instance
+	for (int32 Index = InInstanceIndex; Index < Bodies->Num(); ++Index)
+	{
+		(*Bodies)[Index]->InstanceBodyIndex = Index;
+	}
+}
+
+void UPhysicBasedScatterTool::UpdateSimulatedInstances(bool bInDampVelocity)
 {
-	TArray<AActor*> TempActors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), TempActors);
-	LevelActors = TempActors;
-	for (auto& actor : LevelActors)
+	TArray<FTransform> InstanceTransforms;
+	for (auto& Pair : InstanceBodies)
 	{
-		if (!actor->IsA<AGeometryCollectionActor>())
+		UInstancedStaticMeshComponent* InstancedComponent = Pair.Key;
+		const TArray<TUniquePtr<FBodyInstance>>& Bodies = Pair.Value;
+		if (!IsValid(InstancedComponent) || Bodies.Num() == 0)
 		{
-			auto Prims = GetPrimitives(actor);
-			for (auto& Prim : Prims)
+			continue;
+		}
+
+		bool bAnyAwake = false;
+		InstanceTransforms.Reset(Bodies.Num());
+		for (const TUniquePtr<FBodyInstance>& Body : Bodies)
+		{
+			if (Body->IsInstanceAwake())
 			{
-				if (!Mobilities.Contains(Prim))
+				bAnyAwake = true;
+				if (bInDampVelocity)
 				{
-					Mobilities.Add(Prim, Prim->Mobility.GetValue());
+					Body->SetLinearVelocity(FVector::ZeroVector, false);
+					Body->SetAngularVelocityInRadians(FVector::ZeroVector, false);
 				}
+			}
+			InstanceTransforms.Add(Body->GetUnrealWorldTransform());
+		}
 
-				if (!Physics.Contains(Prim))
-				{
-					Physics.Add(Prim, Prim->IsSimulatingPhysics());
-				}
+		// Once everything of a mesh went to sleep its instances stop changing
+		if (bAnyAwake)
+		{
+			InstancedComponent->BatchUpdateInstancesTransforms(0, InstanceTransforms, true, true, false);
+		}
+	}
+}
 
-				if (!Gravities.Contains(Prim))
-				{
-					Gravities.Add(Prim, Prim->IsGravityEnabled());
-				}
+void UPhysicBasedScatterTool::BakeSimulatedInstances()
+{
+	if (GetNumSimulatedInstances() == 0)
+	{
+		return;
+	}
 
-				if (!Positions.Contains(Prim))
-				{
-					Positions.Add(Prim, Prim->GetComponentLocation());
-				}
+	GetToolManager()->BeginUndoTransaction(LOCTEXT("PhysicalLayoutMode_BakeInstances", "Bake Simulated Instances"));
 
-				if (!Rotations.Contains(Prim))
-				{
-					Rotations.Add(Prim, Prim->GetComponentRotation());
-				}
+	FActorSpawnParameters Params = FActorSpawnParameters();
+	Params.Name = MakeUniqueObjectName(GetWorld()->GetCurrentLevel(), AActor::StaticClass(), FName(TEXT("Simulated_Instances")));
+	Params.NameMode = FActorSpawnParameters::ESpawnActorNameMode::Requested;
+	AActor* BakedActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+	BakedActor->SetActorLabel(Params.Name.ToString());
+
+	USceneComponent* Root = NewObject<USceneComponent>(BakedActor, TEXT("DefaultSceneRoot"), RF_Transactional);
+	BakedActor->SetRootComponent(Root);
+	BakedActor->AddInstanceComponent(Root);
+	Root->RegisterComponent();
+
+	TArray<FTransform> InstanceTransforms;
+	for (const auto& Pair : InstancedComponents)
+	{
+		const TArray<TUniquePtr<FBodyInstance>>* Bodies = InstanceBodies.Find(Pair.Value);
+		if (!Bodies || Bodies->Num() == 0)
+		{
+			continue;
+		}
+
+		InstanceTransforms.Reset(Bodies->Num());
+		for (const TUniquePtr<FBodyInstance>& Body : *Bodies)
+		{
+			InstanceTransforms.Add(Body->GetUnrealWorldTransform());
+		}
+
+		UHierarchicalInstancedStaticMeshComponent* BakedComponent = NewObject<UHierarchicalInstancedStaticMeshComponent>(BakedActor, NAME_None, RF_Transactional);
+		BakedComponent->SetStaticMesh(Pair.Key);
+		BakedComponent->SetupAttachment(Root);
+		BakedActor->AddInstanceComponent(BakedComponent);
+		BakedComponent->RegisterComponent();
+		BakedComponent->AddInstances(InstanceTransforms, false, true);
+	}
+
+	ToolSelectionUtil::SetNewActorSelection(GetToolManager(), BakedActor);
+
+	GetToolManager()->EndUndoTransaction();
+}
 
-				Prim->SetMobility(EComponentMobility::Static);
+void UPhysicBasedScatterTool::ReleaseSimulatedInstances()
+{
+	for (auto& Pair : InstanceBodies)
+	{
+		for (TUniquePtr<FBodyInstance>& Body : Pair.Value)
+		{
+			Body->TermBody();
+		}
+	}
+	InstanceBodies.Reset();
+	InstancedComponents.Reset();
+
+	if (IsValid(InstanceProxyActor))
+	{
+		InstanceProxyActor->Destroy();
+	}
+	InstanceProxyActor = nullptr;
+}
+
+UInstancedStaticMeshComponent* UPhysicBasedScatterTool::GetOrCreateInstancedComponent(UStaticMesh* InStaticMesh)
+{
+	if (!InStaticMesh)
+	{
+		return nullptr;
+	}
+
+	if (TObjectPtr<UInstancedStaticMeshComponent>* Existing = InstancedComponents.Find(InStaticMesh))
+	{
+		return *Existing;
+	}
+
+	if (!IsValid(InstanceProxyActor))
+	{
+		FActorSpawnParameters Params = FActorSpawnParameters();
+		Params.ObjectFlags = RF_Transient;
+		InstanceProxyActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, Params);
+
+		USceneComponent* Root = NewObject<USceneComponent>(InstanceProxyActor, TEXT("DefaultSceneRoot"), RF_Transient);
+		InstanceProxyActor->SetRootComponent(Root);
+		Root->RegisterComponent();
+	}
+
+	// Plain ISM while simulating, every step rewrites all transforms and a HISM would rebuild its tree each time
+	UInstancedStaticMeshComponent* InstancedComponent = NewObject<UInstancedStaticMeshComponent>(InstanceProxyActor, NAME_None, RF_Transient);
+	InstancedComponent->SetStaticMesh(InStaticMesh);
+	InstancedComponent->SetMobility(EComponentMobility::Movable);
+	InstancedComponent->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	InstancedComponent->SetupAttachment(InstanceProxyActor->GetRootComponent());
+	InstancedComponent->RegisterComponent();
+
+	InstancedComponents.Add(InStaticMesh, InstancedComponent);
+	return InstancedComponent;
+}
+
+int32 UPhysicBasedScatterTool::GetNumSimulatedInstances() const
+{
+	int32 NumInstances = 0;
+	for (const auto& Pair : InstanceBodies)
+	{
+		NumInstances += Pair.Value.Num();
+	}
+	return NumInstances;
+}
+
+void UPhysicBasedScatterTool::AddSelectedActor(AActor* InActor)
+{
+	OnLevelActorsAdded(InActor);
+}
+
+void UPhysicBasedScatterTool::CachePhysics()
+{
+	auto FreezePrimitive = [this](UPrimitiveComponent* Prim)
+	{
+		if (!Mobilities.Contains(Prim))
+		{
+			Mobilities.Add(Prim, Prim->Mobility.GetValue());
+		}
+
+		if (!Physics.Contains(Prim))
+		{
+			Physics.Add(Prim, Prim->IsSimulatingPhysics());
+		}
+
+		if (!Gravities.Contains(Prim))
+		{
+			Gravities.Add(Prim, Prim->IsGravityEnabled());
+		}
+
+		if (!Positions.Contains(Prim))
+		{
+			Positions.Add(Prim, Prim->GetComponentLocation());
+		}
+
+		if (!Rotations.Contains(Prim))
+		{
+			Rotations.Add(Prim, Prim->GetComponentRotation());
+		}
+
+		Prim->SetSimulatePhysics(false);
+		Prim->SetMobility(EComponentMobility::Static);
+	};
+
+	// Freeze everything the tool set simulating so only the new selection moves
+	for (auto It = SimulatedPrimitives.CreateIterator(); It; ++It)
+	{
+		UPrimitiveComponent* Prim = It->Get();
+		It.RemoveCurrent();
+		if (IsValid(Prim))
+		{
+			FreezePrimitive(Prim);
+		}
+	}
+
+	// Level actors that simulate on their own are frozen as well, they are put back by ResetPhysics
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		if (It->IsA<AGeometryCollectionActor>())
+		{
+			continue;
+		}
+
+		for (UPrimitiveComponent* Prim : GetPrimitives(*It))
+		{
+			if (IsValid(Prim) && Prim->IsSimulatingPhysics())
+			{
+				FreezePrimitive(Prim);
 			}
 		}
 	}
 }
+
 void UPhysicBasedScatterTool::UpdateSelectionPhysics()
 {
 	if (!bSimulatePhysic)
@@ -1309,9 +1496,42 @@ void UPhysicBasedScatterTool::UpdateSelectionPhysics()
 			Gravities.Add(Prim, Prim->IsGravityEnabled());
 		}
 
+		Prim->SetMobility(EComponentMobility::Movable);
 		Prim->SetSimulatePhysics(bSimulatePhysic);
 		Prim->SetEnableGravity(false);
-		Prim->SetMobility(EComponentMobility::Movable);
+		UpdateSimulatedPrimitive(Prim);
+	}
+}
+
+void UPhysicBasedScatterTool::UpdateSimulatedPrimitive(UPrimitiveComponent* InPrim)
+{
+	if (IsValid(InPrim) && InPrim->IsSimulatingPhysics())
+	{
+		SimulatedPrimitives.Add(InPrim);
+	}
+	else
+	{
+		SimulatedPrimitives.Remove(InPrim);
+	}
+}
+
+void UPhysicBasedScatterTool::DampSimulatedPrimitives()
+{
+	for (auto It = SimulatedPrimitives.CreateIterator(); It; ++It)
+	{
+		UPrimitiveComponent* Prim = It->Get();
+		if (!IsValid(Prim) || !Prim->IsSimulatingPhysics())
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		// Sleeping bodies have no velocity left to damp
+		if (Prim->RigidBodyIsAwake())
+		{
+			Prim->SetPhysicsLinearVelocity(FVector::ZeroVector);
+			Prim->SetPhysicsAngularVelocityInDegrees(FVector::ZeroVector);
+		}
 	}
 }
 
@@ -1382,6 +1602,8 @@ void UPhysicBasedScatterTool::ResetPrimitivePhysics(UPrimitiveComponent* InPrim,
 				InPrim->SetWorldRotation(Rotations[InPrim]);
 			}
 		}
+
+		UpdateSimulatedPrimitive(InPrim);
 	}
 
 }
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "BaseTools/ScriptableModularBehaviorTool.h"
+#include "PhysicsEngine/BodyInstance.h"
 #include "ToolSet/HandyManBaseClasses/HandyManClickDragTool.h"
 #include "PhysicBasedScatterTool.generated.h"
 
@@ -187,6 +188,27 @@ private:
 
 	void SelectPlacedActors(UStaticMesh* InStaticMesh);
 
+	/** Drops one item as a tool owned body rendered by the instanced component of its mesh */
+	void AddSimulatedInstance(UStaticMesh* InStaticMesh, const FTransform& InTransform);
+	
+	/** Removes a dropped instance and its body */
+	void RemoveSimulatedInstance(UInstancedStaticMeshComponent* InComponent, int32 InInstanceIndex);
+	
+	/** Copies the body transforms back into the instances that render them */
+	void UpdateSimulatedInstances(bool bInDampVelocity);
+	
+	/** Bakes the dropped instances into instanced static mesh components on a new actor */
+	void BakeSimulatedInstances();
+	
+	/** Terminates every tool owned body and destroys the instance proxy actor */
+	void ReleaseSimulatedInstances();
+	
+	/** Returns the instanced component that renders a mesh, creating it on first use */
+	UInstancedStaticMeshComponent* GetOrCreateInstancedComponent(UStaticMesh* InStaticMesh);
+	
+	/** Returns the number of dropped instances */
+	int32 GetNumSimulatedInstances() const;
+
 	void AddSelectedActor(AActor *InActor);
 	void CachePhysics();
 
@@ -237,9 +259,19 @@ private:
 	TArray<TObjectPtr<AActor>> LastSpawnedActors;
 	
 	
-	/** All map's actors */
+	/** Transient actor owning the instanced components of the instanced simulation */
+	UPROPERTY()
+	TObjectPtr<AActor> InstanceProxyActor = nullptr;
+	
+	/** Instanced component rendering every dropped item of a mesh */
 	UPROPERTY()
-	TArray<TObjectPtr<AActor>> LevelActors;
+	TMap<TObjectPtr<UStaticMesh>, TObjectPtr<UInstancedStaticMeshComponent>> InstancedComponents;
+	
+	/** Bodies owned by the tool, body i of a component is rendered by its instance i */
+	TMap<TObjectPtr<UInstancedStaticMeshComponent>, TArray<TUniquePtr<FBodyInstance>>> InstanceBodies;
+	
+	/** Primitives the tool has set simulating, kept up to date from the level and selection events so the tick never walks the whole level */
+	TSet<TWeakObjectPtr<UPrimitiveComponent>> SimulatedPrimitives;
 	
 	/** Physics dictionary for all map's actors */
 	UPROPERTY()
@@ -266,6 +298,12 @@ private:
 	/** Updates the selected actor's physics */
 	void UpdateSelectionPhysics();
 	
+	/** Starts or stops tracking a primitive depending on whether it is simulating */
+	void UpdateSimulatedPrimitive(UPrimitiveComponent* InPrim);
+	
+	/** Damps the velocity of every tracked primitive that is still awake */
+	void DampSimulatedPrimitives();
+	
 	/** Resets the physics and transform for a primitive component */
 	void ResetPrimitivePhysics(UPrimitiveComponent* InPrim, bool bResetTransform, bool bForceStatic=false);
 	
@@ -284,6 +322,9 @@ private:
 	/** On Pre Begin Pie event */
 	void OnPreBeginPie(bool InStarted);
 
+	/** On editor selection changed event */
+	void OnSelectionChanged(UObject* InSelection);
+
 
 	bool bSimulatePhysic = true;
 
@@ -291,6 +332,7 @@ private:
 	FDelegateHandle OnLevelActorsAddedHandle;
 	FDelegateHandle OnLevelActorsDeletedHandle;
 	FDelegateHandle OnPreBeginPieHandle;
+	FDelegateHandle OnSelectionChangedHandle;
 	
 #pragma endregion  
 
@@ -366,6 +408,11 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
 	bool bUseSelected = false;
 
+	/** Drop items as bodies rendered through one instanced component per mesh instead of spawning an actor per item.
+	 * Accepting the tool bakes them straight into instanced static mesh components. */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Settings")
+	bool bUseInstancedSimulation = false;
+
 
 	FString GetLayoutMode() const { return LayoutMode; }
 	
@@ -395,6 +442,9 @@ public:
 	/** Returns true if use selectd is enable */
 	bool IsUseSelected () const { return bUseSelected; }
 	
+	/** Returns true if items are dropped as instances */
+	bool IsUsingInstancedSimulation () const { return bUseInstancedSimulation; }
+	
 	/** Returns normal distance for hited polygon */
 	float GetNormalDistance () const { return fNormalDistance; }
 	
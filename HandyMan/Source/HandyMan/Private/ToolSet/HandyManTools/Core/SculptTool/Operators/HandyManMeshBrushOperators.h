@@ -5,6 +5,7 @@
 #include "CoreMinimal.h"
 #include "FrameTypes.h"
 #include "ScriptableInteractiveTool.h"
+#include "ToolSet/HandyManTools/Core/SculptTool/DataTypes/HandyManSculptingTypes.h"
 #include "UObject/Object.h"
 #include "HandyManMeshBrushOperators.generated.h"
 
@@ -72,10 +73,19 @@ class HANDYMAN_API FHandyManMeshSculptFalloffFunc
 public:
 	TUniqueFunction<double(const FHandyManSculptBrushStamp& StampInfo, const FVector3d& Position)> FalloffFunc;
 
+	// Shape FalloffFunc was made from, LastValue for custom functions
+	EHandyManMeshSculptFalloffType FalloffType = EHandyManMeshSculptFalloffType::LastValue;
+
 	inline double Evaluate(const FHandyManSculptBrushStamp& StampInfo, const FVector3d& Position) const
 	{
 		return FalloffFunc(StampInfo, Position);
 	}
+
+	/**
+	 * Falloff of every vertex of a stamp, multiplied by the stamp alpha if bApplyAlpha is set.
+	 * Known shapes go through a kernel compiled for that shape, custom ones fall back to FalloffFunc
+	 */
+	void EvaluateVertices(const FHandyManSculptBrushStamp& StampInfo, const FDynamicMesh3* Mesh, const TArray<int32>& Vertices, TArray<double>& FalloffsOut, bool bApplyAlpha = false) const;
 };
 
 
@@ -122,6 +132,18 @@ public:
 		CurrentOptions = Options;
 	}
 
+protected:
+	// Falloff of each stamp vertex, kept between stamps to reuse the allocation
+	TArray<double> StampFalloffs;
+
+	const TArray<double>& EvaluateStampFalloffs(const FDynamicMesh3* Mesh, const FHandyManSculptBrushStamp& Stamp, const TArray<int32>& Vertices, bool bApplyAlpha = false)
+	{
+		GetFalloff().EvaluateVertices(Stamp, Mesh, Vertices, StampFalloffs, bApplyAlpha);
+		return StampFalloffs;
+	}
+
+public:
+
 	virtual void BeginStroke(const FDynamicMesh3* Mesh, const FHandyManSculptBrushStamp& Stamp, const TArray<int32>& InitialVertices) {}
 	virtual void EndStroke(const FDynamicMesh3* Mesh, const FHandyManSculptBrushStamp& Stamp, const TArray<int32>& FinalVertices) {}
 	virtual void CancelStroke() {}
@@ -42,6 +42,7 @@ public:
 		const FVector3d& StampPos = Stamp.LocalFrame.Origin;
 
 		double UsePower = Stamp.Direction * Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -50,7 +51,7 @@ public:
 			FVector3d Normal = UE::Geometry::FMeshNormals::ComputeVertexNormal(*Mesh, VertIdx);
 			FVector3d MoveVec = UsePower * Normal;
 
-			double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+			double Falloff = Falloffs[k];
 
 			FVector3d NewPos = OrigPos + Falloff * MoveVec;
 			NewPositionsOut[k] = NewPos;
@@ -96,16 +96,17 @@ public:
 
 protected:
 
-	void ApplyFalloff(const FHandyManSculptBrushStamp& Stamp, const TArray<int32>& Vertices, TArray<FVector3d>& NewPositionsOut) const
+	void ApplyFalloff(const FHandyManSculptBrushStamp& Stamp, const TArray<int32>& Vertices, TArray<FVector3d>& NewPositionsOut)
 	{
 		int32 NumV = Vertices.Num();
 		bool bParallel = true;
-		ParallelFor(NumV, [&Stamp, &Vertices, &NewPositionsOut, this](int32 k)
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
+		ParallelFor(NumV, [&Stamp, &Vertices, &NewPositionsOut, &Falloffs, this](int32 k)
 			{
 				int32 VertIdx = Vertices[k];
 				FVector3d OrigPos = Mesh->GetVertex(VertIdx);
 
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+				double Falloff = Falloffs[k];
 
 				double Alpha = FMath::Clamp(Falloff, 0., 1.);
 
@@ -54,7 +54,7 @@ public:
 		double UsePower = Stamp.Direction * Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
 		double MaxOffset = Stamp.Radius;
 
-		bool bHaveAlpha = Stamp.HasAlpha();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices, true);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -69,10 +69,8 @@ public:
 			}
 			else
 			{
-				double Alpha = (bHaveAlpha) ? Stamp.StampAlphaFunc(Stamp, OrigPos) : 1.0;
-
 				FVector3d MoveVec = UsePower * BaseNormal;
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos) * Alpha;
+				double Falloff = Falloffs[k];
 				FVector3d NewPos = OrigPos + Falloff * MoveVec;
 				NewPositionsOut[k] = NewPos;
 			}
@@ -139,7 +137,7 @@ public:
 		double UsePower = Stamp.Direction * Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
 		double MaxOffset = Stamp.Radius;
 
-		bool bHaveAlpha = Stamp.HasAlpha();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices, true);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -154,10 +152,8 @@ public:
 			}
 			else
 			{
-				double Alpha = (bHaveAlpha) ? Stamp.StampAlphaFunc(Stamp, OrigPos) : 1.0;
-
 				FVector3d MoveVec = UsePower * StampNormal;
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos) * Alpha;
+				double Falloff = Falloffs[k];
 				FVector3d NewPos = OrigPos + Falloff * MoveVec;
 				NewPositionsOut[k] = NewPos;
 			}
@@ -232,7 +228,7 @@ public:
 		UHandyManSculptMaxBrushOpProps* Props = GetPropertySetAs<UHandyManSculptMaxBrushOpProps>();
 		double MaxOffset = (Props->bUseFixedHeight) ? Props->FixedHeight : (Props->MaxHeight * Stamp.Radius);
 
-		bool bHaveAlpha = Stamp.HasAlpha();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices, true);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -247,10 +243,8 @@ public:
 			}
 			else
 			{
-				double Alpha = (bHaveAlpha) ? Stamp.StampAlphaFunc(Stamp, OrigPos) : 1.0;
-
 				FVector3d MoveVec = UsePower * BaseNormal;
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos) * Alpha;
+				double Falloff = Falloffs[k];
 				FVector3d NewPos = OrigPos + Falloff * MoveVec;
 
 				FVector3d DeltaPos = NewPos - BasePos;
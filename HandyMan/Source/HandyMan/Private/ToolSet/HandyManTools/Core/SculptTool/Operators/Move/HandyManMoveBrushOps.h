@@ -62,12 +62,14 @@ public:
 			MoveVec = Stamp.LocalFrame.FromFrameVector(Stamp.WorldFrame.ToFrameVector(WorldMoveVec));
 		}
 
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
+
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
 			int32 VertIdx = Vertices[k];
 			FVector3d OrigPos = Mesh->GetVertex(VertIdx);
 
-			double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+			double Falloff = Falloffs[k];
 
 			FVector3d NewPos = OrigPos + Falloff * MoveVec;
 			NewPositionsOut[k] = NewPos;
@@ -127,6 +127,7 @@ public:
 		const FVector3d& StampPos = Stamp.LocalFrame.Origin;
 
 		double UseSpeed = Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -139,7 +140,7 @@ public:
 			FVector3d NewPos = OrigPos;
 			if (Dot * PlaneSign >= 0)
 			{
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+				double Falloff = Falloffs[k];
 				FVector3d MoveVec = Falloff * UseSpeed * Delta;
 				double MaxDist = UE::Geometry::Normalize(Delta);
 				NewPos = (MoveVec.SquaredLength() > MaxDist * MaxDist) ?
@@ -79,6 +79,7 @@ public:
 	{
 		const FVector3d& StampPos = Stamp.LocalFrame.Origin;
 		bool bPreserveUVFlow = GetPropertySetAs<UHandyManBaseSmoothBrushOpProps>()->GetPreserveUVFlow();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -86,7 +87,7 @@ public:
 
 			FVector3d OrigPos = Mesh->GetVertex(VertIdx);
 
-			double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+			double Falloff = Falloffs[k];
 
 			FVector3d SmoothedPos = OrigPos;
 			if (bPreserveUVFlow)
@@ -144,6 +145,7 @@ public:
 		const FVector3d& StampPos = Stamp.LocalFrame.Origin;
 		double Direction = Stamp.Direction;
 		bool bPreserveUVFlow = GetPropertySetAs<UHandyManBaseSmoothBrushOpProps>()->GetPreserveUVFlow();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -152,7 +154,7 @@ public:
 			FVector3d OrigPos = Mesh->GetVertex(VertIdx);
 			FVector3d Normal = UE::Geometry::FMeshNormals::ComputeVertexNormal(*Mesh, VertIdx);
 
-			double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+			double Falloff = Falloffs[k];
 
 			FVector3d SmoothedPos = OrigPos;
 			if (bPreserveUVFlow)
@@ -226,6 +228,7 @@ public:
 		double UseSpeed = Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
 		const FFrame3d& FlattenPlane = Stamp.RegionPlane;
 		FVector3d PlaneZ = FlattenPlane.Z();
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -239,7 +242,7 @@ public:
 			FVector3d NewPos = OrigPos;
 			if (PlaneDot * PlaneSign >= 0)
 			{
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+				double Falloff = Falloffs[k];
 				FVector3d MoveVec = Falloff * UseSpeed * MoveDelta;
 				double MaxDist = UE::Geometry::Normalize(MoveDelta);
 				NewPos = (MoveVec.SquaredLength() > MaxDist * MaxDist) ?
@@ -304,6 +307,7 @@ public:
 	{
 		double UsePower = Stamp.Power * Stamp.Radius * Stamp.DeltaTime * BrushSpeedTuning;
 		double MaxOffset = Stamp.Radius;
+		const TArray<double>& Falloffs = EvaluateStampFalloffs(Mesh, Stamp, Vertices);
 
 		ParallelFor(Vertices.Num(), [&](int32 k)
 		{
@@ -319,7 +323,7 @@ public:
 			else
 			{
 				FVector3d MoveVec = (BasePos - OrigPos); 
-				double Falloff = GetFalloff().Evaluate(Stamp, OrigPos);
+				double Falloff = Falloffs[k];
 				double MoveDist = Falloff * UsePower;
 				if (MoveVec.SquaredLength() < MoveDist * MoveDist)
 				{
@@ -349,6 +349,7 @@ void UHandyManSculptTool::SetActiveSecondaryBrushType(int32 Identifier)
 	SecondaryBrushOp = (*Factory)->Build();
 	TSharedPtr<FHandyManMeshSculptFalloffFunc> SecondaryFalloff = MakeShared<FHandyManMeshSculptFalloffFunc>();;
 	SecondaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeStandardSmoothFalloff();
+	SecondaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::Smooth;
 	SecondaryBrushOp->Falloff = SecondaryFalloff;
 
 	TObjectPtr<UHandyManMeshSculptBrushOpProps>* FoundProps = SecondaryBrushOpPropSets.Find(Identifier);
@@ -409,27 +410,35 @@ void UHandyManSculptTool::SetPrimaryFalloffType(EHandyManMeshSculptFalloffType F
 	default:
 	case EHandyManMeshSculptFalloffType::Smooth:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeStandardSmoothFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::Smooth;
 		break;
 	case EHandyManMeshSculptFalloffType::Linear:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeLinearFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::Linear;
 		break;
 	case EHandyManMeshSculptFalloffType::Inverse:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeInverseFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::Inverse;
 		break;
 	case EHandyManMeshSculptFalloffType::Round:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeRoundFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::Round;
 		break;
 	case EHandyManMeshSculptFalloffType::BoxSmooth:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeSmoothBoxFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::BoxSmooth;
 		break;
 	case EHandyManMeshSculptFalloffType::BoxLinear:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeLinearBoxFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::BoxLinear;
 		break;
 	case EHandyManMeshSculptFalloffType::BoxInverse:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeInverseBoxFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::BoxInverse;
 		break;
 	case EHandyManMeshSculptFalloffType::BoxRound:
 		PrimaryFalloff->FalloffFunc = HandyMan::SculptFalloffs::MakeRoundBoxFalloff();
+		PrimaryFalloff->FalloffType = EHandyManMeshSculptFalloffType::BoxRound;
 		break;
 	}
 }
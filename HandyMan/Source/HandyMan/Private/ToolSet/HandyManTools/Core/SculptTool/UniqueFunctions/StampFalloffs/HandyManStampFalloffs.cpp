@@ -2,3 +2,179 @@
 
 
 #include "HandyManStampFalloffs.h"
+
+#include "Async/ParallelFor.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+
+namespace HandyMan
+{
+	namespace SculptFalloffs
+	{
+		namespace Kernels
+		{
+			// Vertices gathered per block, small enough to stay on the stack
+			static constexpr int32 BlockSize = 256;
+
+			/* Everything the kernels need from a stamp, computed once per stamp */
+			struct FStampFalloffParams
+			{
+				FVector3d Origin;
+				FVector3d AxisX;
+				FVector3d AxisY;
+				FVector3d AxisZ;
+
+				// Radial shapes
+				double InvRadius;
+				double FalloffT;
+				double InvFalloffRange;
+
+				// Box shapes
+				double BoxHalfWidth;
+				double InvFalloffWidth;
+
+				explicit FStampFalloffParams(const FHandyManSculptBrushStamp& Stamp)
+				{
+					Origin = Stamp.LocalFrame.Origin;
+					AxisX = Stamp.LocalFrame.X();
+					AxisY = Stamp.LocalFrame.Y();
+					AxisZ = Stamp.LocalFrame.Z();
+
+					FalloffT = FMathd::Clamp(1.0 - Stamp.Falloff, 0.0, 1.0);
+					InvRadius = 1.0 / FMathd::Max(Stamp.Radius, FMathd::ZeroTolerance);
+					InvFalloffRange = 1.0 / FMathd::Max(1.0 - FalloffT, FMathd::ZeroTolerance);
+
+					const double InnerRadius = FalloffT * Stamp.Radius;
+					BoxHalfWidth = FMathd::InvSqrt2 * InnerRadius;
+					InvFalloffWidth = 1.0 / FMathd::Max(Stamp.Radius - InnerRadius, FMathd::ZeroTolerance);
+				}
+			};
+
+			// Curves over the normalized distance into the falloff band, shared by the radial and box shapes
+			struct FSmoothCurve
+			{
+				static FORCEINLINE double Apply(const double T) { const double W = 1.0 - T * T; return W * W * W; }
+			};
+
+			struct FLinearCurve
+			{
+				static FORCEINLINE double Apply(const double T) { return 1.0 - T; }
+			};
+
+			struct FInverseCurve
+			{
+				static FORCEINLINE double Apply(const double T) { const double W = 1.0 - T; return W * W * W; }
+			};
+
+			struct FRoundCurve
+			{
+				static FORCEINLINE double Apply(const double T) { return 1.0 - T * T; }
+			};
+
+			/* Same results as the matching MakeXXXFalloff functions, written without branches so the loops vectorize */
+			template<typename CurveType, bool bBoxShape, bool bApplyAlpha>
+			void EvaluateBlock(const FStampFalloffParams& Params, const FHandyManSculptBrushStamp& Stamp, const double* RESTRICT X, const double* RESTRICT Y, const double* RESTRICT Z, const int32 Count, double* RESTRICT FalloffsOut)
+			{
+				for (int32 Index = 0; Index < Count; ++Index)
+				{
+					const double DX = X[Index] - Params.Origin.X;
+					const double DY = Y[Index] - Params.Origin.Y;
+					const double DZ = Z[Index] - Params.Origin.Z;
+
+					if constexpr (bBoxShape)
+					{
+						// Distance to the inner box in stamp space, zero inside of it
+						const double LX = FMathd::Max(FMathd::Abs(DX * Params.AxisX.X + DY * Params.AxisX.Y + DZ * Params.AxisX.Z) - Params.BoxHalfWidth, 0.0);
+						const double LY = FMathd::Max(FMathd::Abs(DX * Params.AxisY.X + DY * Params.AxisY.Y + DZ * Params.AxisY.Z) - Params.BoxHalfWidth, 0.0);
+						const double LZ = FMathd::Max(FMathd::Abs(DX * Params.AxisZ.X + DY * Params.AxisZ.Y + DZ * Params.AxisZ.Z) - Params.BoxHalfWidth, 0.0);
+						const double T = FMathd::Min(FMathd::Sqrt(LX * LX + LY * LY + LZ * LZ) * Params.InvFalloffWidth, 1.0);
+						FalloffsOut[Index] = CurveType::Apply(T);
+					}
+					else
+					{
+						const double UnitDistance = FMathd::Sqrt(DX * DX + DY * DY + DZ * DZ) * Params.InvRadius;
+						const double T = FMathd::Clamp((UnitDistance - Params.FalloffT) * Params.InvFalloffRange, 0.0, 1.0);
+						FalloffsOut[Index] = UnitDistance > Params.FalloffT ? CurveType::Apply(T) : 1.0;
+					}
+				}
+
+				if constexpr (bApplyAlpha)
+				{
+					for (int32 Index = 0; Index < Count; ++Index)
+					{
+						FalloffsOut[Index] *= Stamp.StampAlphaFunc(Stamp, FVector3d(X[Index], Y[Index], Z[Index]));
+					}
+				}
+			}
+
+			typedef void (*FEvaluateBlockFunc)(const FStampFalloffParams&, const FHandyManSculptBrushStamp&, const double*, const double*, const double*, int32, double*);
+
+			template<typename CurveType, bool bBoxShape>
+			FEvaluateBlockFunc SelectAlpha(const bool bApplyAlpha)
+			{
+				return bApplyAlpha ? &EvaluateBlock<CurveType, bBoxShape, true> : &EvaluateBlock<CurveType, bBoxShape, false>;
+			}
+
+			static FEvaluateBlockFunc SelectKernel(const EHandyManMeshSculptFalloffType FalloffType, const bool bApplyAlpha)
+			{
+				switch (FalloffType)
+				{
+				case EHandyManMeshSculptFalloffType::Smooth:		return SelectAlpha<FSmoothCurve, false>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::Linear:		return SelectAlpha<FLinearCurve, false>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::Inverse:		return SelectAlpha<FInverseCurve, false>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::Round:			return SelectAlpha<FRoundCurve, false>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::BoxSmooth:		return SelectAlpha<FSmoothCurve, true>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::BoxLinear:		return SelectAlpha<FLinearCurve, true>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::BoxInverse:	return SelectAlpha<FInverseCurve, true>(bApplyAlpha);
+				case EHandyManMeshSculptFalloffType::BoxRound:		return SelectAlpha<FRoundCurve, true>(bApplyAlpha);
+				default:											return nullptr;
+				}
+			}
+		}
+	}
+}
+
+
+void FHandyManMeshSculptFalloffFunc::EvaluateVertices(const FHandyManSculptBrushStamp& StampInfo, const FDynamicMesh3* Mesh, const TArray<int32>& Vertices, TArray<double>& FalloffsOut, bool bApplyAlpha) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FHandyManMeshSculptFalloffFunc::EvaluateVertices);
+	using namespace HandyMan::SculptFalloffs::Kernels;
+
+	const int32 NumVertices = Vertices.Num();
+	FalloffsOut.SetNumUninitialized(NumVertices, EAllowShrinking::No);
+
+	bApplyAlpha = bApplyAlpha && StampInfo.HasAlpha();
+
+	const FEvaluateBlockFunc Kernel = SelectKernel(FalloffType, bApplyAlpha);
+	if (!Kernel)
+	{
+		ParallelFor(NumVertices, [&](int32 k)
+		{
+			const FVector3d Position = Mesh->GetVertex(Vertices[k]);
+			const double Alpha = bApplyAlpha ? StampInfo.StampAlphaFunc(StampInfo, Position) : 1.0;
+			FalloffsOut[k] = FalloffFunc(StampInfo, Position) * Alpha;
+		});
+		return;
+	}
+
+	const FStampFalloffParams Params(StampInfo);
+	const int32 NumBlocks = FMath::DivideAndRoundUp(NumVertices, BlockSize);
+
+	// Positions are gathered into separate X/Y/Z arrays so the kernel reads them contiguously
+	ParallelFor(NumBlocks, [&](int32 BlockIndex)
+	{
+		const int32 Start = BlockIndex * BlockSize;
+		const int32 Count = FMath::Min(BlockSize, NumVertices - Start);
+
+		double X[BlockSize], Y[BlockSize], Z[BlockSize];
+		for (int32 Index = 0; Index < Count; ++Index)
+		{
+			const FVector3d Position = Mesh->GetVertex(Vertices[Start + Index]);
+			X[Index] = Position.X;
+			Y[Index] = Position.Y;
+			Z[Index] = Position.Z;
+		}
+
+		Kernel(Params, StampInfo, X, Y, Z, Count, &FalloffsOut[Start]);
+	});
+}
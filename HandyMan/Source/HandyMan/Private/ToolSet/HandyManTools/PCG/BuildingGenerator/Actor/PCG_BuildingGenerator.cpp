@@ -4,10 +4,15 @@
 #include "PCG_BuildingGenerator.h"
 
 #include "PCGGraph.h"
+#include "DynamicMeshEditor.h"
+#include "UDynamicMesh.h"
+#include "DynamicMesh/DynamicMeshAttributeSet.h"
+#include "DynamicMesh/MeshTransforms.h"
 #include "Engine/StaticMeshActor.h"
 #include "GeometryScript/MeshAssetFunctions.h"
 #include "GeometryScript/MeshBasicEditFunctions.h"
 #include "GeometryScript/MeshBooleanFunctions.h"
+#include "GeometryScript/MeshMaterialFunctions.h"
 #include "GeometryScript/MeshModelingFunctions.h"
 #include "GeometryScript/MeshQueryFunctions.h"
 #include "GeometryScript/MeshSelectionFunctions.h"
@@ -20,9 +25,8 @@
 #include "Kismet/KismetSystemLibrary.h"
 #include "ModelingUtilities/HandyManModelingUtilities.h"
 #include "PolyPathUtilities/HandyManPolyPathUtilities.h"
+#include "ToolSet/HandyManTools/PCG/BuildingGenerator/Operators/BuildingOpeningsOp.h"
 
-
-// Sets default values
 APCG_BuildingGenerator::APCG_BuildingGenerator()
 {
 	// Set this actor to call Tick() every frame.  You can turn this off to improve performance if you don't need it.
@@ -83,8 +87,27 @@ void APCG_BuildingGenerator::RebuildGeneratedMesh(UDynamicMesh* TargetMesh)
 {
 	ReleaseAllComputeMeshes();
 	GenerateExteriorWalls(TargetMesh);
-	GenerateFloorMeshes(TargetMesh);
-	GenerateRoofMesh(TargetMesh);
+
+	// Floors and roof are built apart from the walls so opening edits can reuse them
+	auto* RemainderMesh = AllocateComputeMesh();
+	RemainderMesh->Reset();
+	GenerateFloorMeshes(RemainderMesh);
+	GenerateRoofMesh(RemainderMesh);
+	CachedRemainderMesh = MakeShared<const UE::Geometry::FDynamicMesh3>(RemainderMesh->GetMeshRef());
+
+	if (TargetMesh)
+	{
+		// Keep the floor material slots on the walls mesh
+		TargetMesh->EditMesh([this](UE::Geometry::FDynamicMesh3& EditMesh)
+		{
+			EditMesh.EnableMatchingAttributes(*CachedRemainderMesh, false);
+
+			UE::Geometry::FMeshIndexMappings Mappings;
+			UE::Geometry::FDynamicMeshEditor Editor(&EditMesh);
+			Editor.AppendMesh(CachedRemainderMesh.Get(), Mappings);
+		}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown);
+	}
+	
 	ForceCookPCG();
 	
 	Super::RebuildGeneratedMesh(TargetMesh);
@@ -131,6 +154,7 @@ void APCG_BuildingGenerator::CacheInputActor(AActor* InputActor)
 	
 	const auto Bounds = UGeometryScriptLibrary_MeshQueryFunctions::GetMeshBoundingBox(OriginalMesh);
 	BuildingHeight = Bounds.GetExtent().Z * 2;
+	InvalidateFloorSegments();
 
 	InputActor->Destroy();
 	CreateFloorAndRoofSplines();
@@ -146,6 +170,15 @@ void APCG_BuildingGenerator::SetFloorMaterial(const int32 Floor, const TSoftObje
 	{
 		FloorMaterialMap.Add(Floor, Material);
 	}
+
+	// Floors that end up sharing a material with another floor move to its slot, the affected floors get retagged
+	RerunConstructionScripts();
+}
+
+void APCG_BuildingGenerator::InvalidateFloorSegments()
+{
+	CachedFloorProfile.Reset();
+	FloorSegments.Empty();
 }
 
 void APCG_BuildingGenerator::CreateBaseSplinesFromPolyPaths(const TArray<FGeometryScriptPolyPath>& Paths)
@@ -394,7 +427,7 @@ void APCG_BuildingGenerator::RemoveGeneratedOpeningEntry(const FGeneratedOpening
 	RerunConstructionScripts();
 }
 
-void APCG_BuildingGenerator::UpdatedGeneratedOpenings(const TArray<FGeneratedOpening>& Entries)
+void APCG_BuildingGenerator::UpdatedGeneratedOpenings(const TArray<FGeneratedOpening>& Entries, const bool bRerunConstruction)
 {
 	GeneratedOpenings.Empty();
 	for (const auto Entry : Entries)
@@ -425,7 +458,11 @@ void APCG_BuildingGenerator::UpdatedGeneratedOpenings(const TArray<FGeneratedOpe
 		}
 		
 	}
-	RerunConstructionScripts();
+
+	if (bRerunConstruction)
+	{
+		RerunConstructionScripts();
+	}
 }
 
 TArray<FGeneratedOpening> APCG_BuildingGenerator::GetGeneratedOpenings(const UObject* Key) const
@@ -468,48 +505,162 @@ void APCG_BuildingGenerator::GenerateRoofMesh(UDynamicMesh* TargetMesh)
 	// TODO - Here I would like to procedurally place smart meshes along the roof spline.
 }
 
-TArray<FGeometryScriptPolyPath> APCG_BuildingGenerator::UseTopFaceForFloor(UDynamicMesh* TargetMesh, const double FloorHeight, const bool bApplyAfterExtrude)
+TArray<FGeometryScriptPolyPath> APCG_BuildingGenerator::UseTopFaceForFloor(UDynamicMesh* TargetMesh, const int32 SegmentIndex, const double FloorHeight, const bool bApplyAfterExtrude)
 {
-	// Duplicate the roof mesh
-	auto* ComputeMesh = AllocateComputeMesh();
-	auto FloorMesh = UHandyManModelingUtilities::GenerateMeshFromPlanarFace(ComputeMesh, OriginalMesh);
+	const int32 MaterialID = GetFloorMaterialID(SegmentIndex);
+	FBuildingFloorSegment& Segment = FloorSegments.FindOrAdd(SegmentIndex);
+
+	if (!Segment.HasSameShape(WallThickness, bApplyAfterExtrude))
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(APCG_BuildingGenerator::UseTopFaceForFloor);
+
+		// Copy the ground level profile
+		auto* FloorMesh = AllocateComputeMesh();
+		FloorMesh->SetMesh(GetFloorProfile());
+			
+		// Move it up to its floor level
+		FloorMesh = UGeometryScriptLibrary_MeshTransformFunctions::TranslateMesh(FloorMesh, FVector(0, 0, (FloorHeight - WallThickness)));
 
-	// Move it down to ground level
-	FloorMesh = UGeometryScriptLibrary_MeshTransformFunctions::TranslateMesh(FloorMesh, FVector(0, 0, -BuildingHeight));
+		// Extrude the mesh to give it some thickness
+		FGeometryScriptMeshSelection Selection;
+		UGeometryScriptLibrary_MeshSelectionFunctions::CreateSelectAllMeshSelection(FloorMesh, Selection);
+
+		TArray<FGeometryScriptPolyPath> ArrayOfPaths;
+		if (!bApplyAfterExtrude)
+		{
+			ArrayOfPaths = UHandyManPolyPathUtilities::CreatePolyPathFromPlanarFaces(
+			FloorMesh, {FVector(0, 0, 1)}, nullptr);
 		
+		}
+
+		FGeometryScriptMeshLinearExtrudeOptions ExtrudeOptions;
+		ExtrudeOptions.Direction = FVector(0, 0, 1);
+		ExtrudeOptions.Distance = WallThickness;
+		ExtrudeOptions.AreaMode = EGeometryScriptPolyOperationArea::EntireSelection;
 		
-	// Move it up to its floor level
-	FloorMesh = UGeometryScriptLibrary_MeshTransformFunctions::TranslateMesh(FloorMesh, FVector(0, 0, (FloorHeight - WallThickness)));
+		FloorMesh = UGeometryScriptLibrary_MeshModelingFunctions::ApplyMeshLinearExtrudeFaces(FloorMesh, ExtrudeOptions, Selection);
 
-	// Extrude the mesh to give it some thickness
-	FGeometryScriptMeshSelection Selection;
-	UGeometryScriptLibrary_MeshSelectionFunctions::CreateSelectAllMeshSelection(FloorMesh, Selection);
+		if (bApplyAfterExtrude)
+		{
+			ArrayOfPaths = UHandyManPolyPathUtilities::CreatePolyPathFromPlanarFaces(
+			FloorMesh, {FVector(0, 0, 1)}, nullptr);
+		}
 
-	TArray<FGeometryScriptPolyPath> ArrayOfPaths;
-	if (!bApplyAfterExtrude)
-	{
-		ArrayOfPaths = UHandyManPolyPathUtilities::CreatePolyPathFromPlanarFaces(
-		FloorMesh, {FVector(0, 0, 1)}, nullptr);
-	
+		UGeometryScriptLibrary_MeshMaterialFunctions::SetAllTriangleMaterialID(FloorMesh, MaterialID);
+
+		Segment.Height = FloorHeight;
+		Segment.Thickness = WallThickness;
+		Segment.MaterialID = MaterialID;
+		Segment.bPathsAfterExtrude = bApplyAfterExtrude;
+		Segment.Paths = MoveTemp(ArrayOfPaths);
+		Segment.Mesh = MakeShared<const UE::Geometry::FDynamicMesh3>(FloorMesh->GetMeshRef());
 	}
+	else if (Segment.Height != FloorHeight)
+	{
+		// Only the height changed, move the cached slab instead of extruding it again
+		const double Delta = FloorHeight - Segment.Height;
 
-	FGeometryScriptMeshLinearExtrudeOptions ExtrudeOptions;
-	ExtrudeOptions.Direction = FVector(0, 0, 1);
-	ExtrudeOptions.Distance = WallThickness;
-	ExtrudeOptions.AreaMode = EGeometryScriptPolyOperationArea::EntireSelection;
-	
-	FloorMesh = UGeometryScriptLibrary_MeshModelingFunctions::ApplyMeshLinearExtrudeFaces(FloorMesh, ExtrudeOptions, Selection);
+		UE::Geometry::FDynamicMesh3 MovedMesh(*Segment.Mesh);
+		UE::Geometry::MeshTransforms::Translate(MovedMesh, FVector3d(0, 0, Delta));
+		Segment.Mesh = MakeShared<const UE::Geometry::FDynamicMesh3>(MoveTemp(MovedMesh));
 
-	if (bApplyAfterExtrude)
+		// The point arrays are shared with the paths handed out before, copy them
+		for (FGeometryScriptPolyPath& Path : Segment.Paths)
+		{
+			if (!Path.Path.IsValid()) continue;
+
+			TSharedPtr<TArray<FVector>> MovedPoints = MakeShared<TArray<FVector>>(*Path.Path);
+			for (FVector& Point : *MovedPoints)
+			{
+				Point.Z += Delta;
+			}
+			Path.Path = MovedPoints;
+		}
+
+		Segment.Height = FloorHeight;
+	}
+
+	if (Segment.MaterialID != MaterialID)
 	{
-		ArrayOfPaths = UHandyManPolyPathUtilities::CreatePolyPathFromPlanarFaces(
-		FloorMesh, {FVector(0, 0, 1)}, nullptr);
+		// Only the material slot changed, retag the cached slab
+		UE::Geometry::FDynamicMesh3 RetaggedMesh(*Segment.Mesh);
+		if (UE::Geometry::FDynamicMeshMaterialAttribute* MaterialIDs = RetaggedMesh.HasAttributes() ? RetaggedMesh.Attributes()->GetMaterialID() : nullptr)
+		{
+			for (const int32 TriangleID : RetaggedMesh.TriangleIndicesItr())
+			{
+				MaterialIDs->SetValue(TriangleID, MaterialID);
+			}
+		}
+		Segment.Mesh = MakeShared<const UE::Geometry::FDynamicMesh3>(MoveTemp(RetaggedMesh));
+		Segment.MaterialID = MaterialID;
 	}
 
 	// Append it to the existing mesh.
-	UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(TargetMesh, FloorMesh, FTransform::Identity);
+	TargetMesh->EditMesh([&Segment](UE::Geometry::FDynamicMesh3& EditMesh)
+	{
+		EditMesh.EnableMatchingAttributes(*Segment.Mesh, false);
+
+		UE::Geometry::FMeshIndexMappings Mappings;
+		UE::Geometry::FDynamicMeshEditor Editor(&EditMesh);
+		Editor.AppendMesh(Segment.Mesh.Get(), Mappings);
+	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown);
+
+	return Segment.Paths;
+}
+
+const UE::Geometry::FDynamicMesh3& APCG_BuildingGenerator::GetFloorProfile()
+{
+	if (!CachedFloorProfile || CachedFloorProfileHeight != BuildingHeight)
+	{
+		// Duplicate the roof mesh
+		auto* ComputeMesh = AllocateComputeMesh();
+		auto FloorMesh = UHandyManModelingUtilities::GenerateMeshFromPlanarFace(ComputeMesh, OriginalMesh);
+
+		// Move it down to ground level
+		FloorMesh = UGeometryScriptLibrary_MeshTransformFunctions::TranslateMesh(FloorMesh, FVector(0, 0, -BuildingHeight));
+
+		CachedFloorProfile = MakeShared<const UE::Geometry::FDynamicMesh3>(FloorMesh->GetMeshRef());
+		CachedFloorProfileHeight = BuildingHeight;
+	}
+
+	return *CachedFloorProfile;
+}
+
+TSoftObjectPtr<UMaterialInterface> APCG_BuildingGenerator::GetFloorMaterial(const int32 SegmentIndex) const
+{
+	TSoftObjectPtr<UMaterialInterface> Material = bUseConsistentFloorMaterial ? FloorMaterial : FloorMaterialMap.FindRef(static_cast<uint8>(SegmentIndex));
+	return Material.IsNull() ? BuildingMaterial : Material;
+}
+
+int32 APCG_BuildingGenerator::GetFloorMaterialID(const int32 SegmentIndex)
+{
+	// The roof and the floors without a material of their own share the building material slot
+	if (SegmentIndex == RoofSegmentIndex)
+	{
+		return 0;
+	}
+
+	const TSoftObjectPtr<UMaterialInterface> Material = GetFloorMaterial(SegmentIndex);
+	if (Material.IsNull() || Material == BuildingMaterial)
+	{
+		return 0;
+	}
 
-	return ArrayOfPaths;
+	// Every distinct floor material gets one slot after the building material
+	return 1 + FloorMaterialSlots.AddUnique(Material);
+}
+
+void APCG_BuildingGenerator::ApplyFloorMaterials()
+{
+	if (!DynamicMeshComponent)
+	{
+		return;
+	}
+
+	for (int32 SlotIndex = 0; SlotIndex < FloorMaterialSlots.Num(); ++SlotIndex)
+	{
+		DynamicMeshComponent->SetMaterial(1 + SlotIndex, FloorMaterialSlots[SlotIndex].LoadSynchronous());
+	}
 }
 
 void APCG_BuildingGenerator::GenerateFloorMeshes(UDynamicMesh* TargetMesh)
@@ -527,6 +678,8 @@ void APCG_BuildingGenerator::GenerateFloorMeshes(UDynamicMesh* TargetMesh)
 	*/
 	
 	TArray<FGeometryScriptPolyPath> NewFloorPaths;
+	TSet<int32> UsedSegments;
+	FloorMaterialSlots.Reset();
 	
 	for (int i = 0; i < NumberOfFloors; ++i)
 	{
@@ -540,7 +693,8 @@ void APCG_BuildingGenerator::GenerateFloorMeshes(UDynamicMesh* TargetMesh)
 			continue;
 		}
 		
-		NewFloorPaths.Append(UseTopFaceForFloor(TargetMesh, FloorHeight, true));
+		NewFloorPaths.Append(UseTopFaceForFloor(TargetMesh, i, FloorHeight, true));
+		UsedSegments.Add(i);
 		
 	}
 
@@ -554,8 +708,20 @@ void APCG_BuildingGenerator::GenerateFloorMeshes(UDynamicMesh* TargetMesh)
 	// If the building has an open roof do not create the mesh for it.
 	if (!bHasOpenRoof)
 	{
-		UseTopFaceForFloor(TargetMesh, BuildingHeight);
+		UseTopFaceForFloor(TargetMesh, RoofSegmentIndex, BuildingHeight);
+		UsedSegments.Add(RoofSegmentIndex);
+	}
+
+	// Forget the floors that are no longer generated
+	for (auto It = FloorSegments.CreateIterator(); It; ++It)
+	{
+		if (!UsedSegments.Contains(It.Key()))
+		{
+			It.RemoveCurrent();
+		}
 	}
+
+	ApplyFloorMaterials();
 	
 }
 
@@ -571,6 +737,7 @@ void APCG_BuildingGenerator::GenerateExteriorWalls(UDynamicMesh* TargetMesh)
 	}
 	
 	UDynamicMesh* CombinedSplinesMesh = nullptr;
+	CachedWallMesh.Reset();
 	auto TempMesh = AllocateComputeMesh();
 	
 	if (BaseSplines.Contains(0))
@@ -584,6 +751,11 @@ void APCG_BuildingGenerator::GenerateExteriorWalls(UDynamicMesh* TargetMesh)
 		CombinedSplinesMesh = UHandyManModelingUtilities::GenerateCollisionGeometryAlongSpline(SweepOptions, ESplineCoordinateSpace::Local, nullptr);
 	}
 
+	if (CombinedSplinesMesh)
+	{
+		CachedWallMesh = MakeShared<const UE::Geometry::FDynamicMesh3>(CombinedSplinesMesh->GetMeshRef());
+	}
+
 	AppendOpeningToMesh(CombinedSplinesMesh);
 
 	UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(TargetMesh ? TargetMesh : GetDynamicMeshComponent()->GetDynamicMesh(), CombinedSplinesMesh, FTransform::Identity);
@@ -598,40 +770,43 @@ void APCG_BuildingGenerator::GenerateExteriorWalls(UDynamicMesh* TargetMesh)
 
 void APCG_BuildingGenerator::AppendOpeningToMesh(UDynamicMesh* TargetMesh)
 {
-	// Iterate over the generated openings
-	auto* Booleans = AllocateComputeMesh();
+	TRACE_CPUPROFILER_EVENT_SCOPE(APCG_BuildingGenerator::AppendOpeningToMesh);
+
+	// Cutters are taken before the openings are fit to the walls
+	FBuildingOpeningsOp Op;
+	GatherOpeningCutters(Op.Cutters);
+	ApplyOpeningFit();
+
+	if (!TargetMesh)
+	{
+		return;
+	}
+
+	Op.WallMesh = CachedWallMesh;
+	Op.CalculateResult(nullptr);
+	TargetMesh->SetMesh(MoveTemp(*Op.ExtractResult()));
+}
+
+void APCG_BuildingGenerator::GatherOpeningCutters(TArray<FBuildingOpeningCutter>& OutCutters) const
+{
 	for (const auto& Entry : GeneratedOpenings)
 	{
 		float CurrentSizeX = 1.f;
 
-		FVector Extent = FVector::One();
-
 		if (Entry.Key.IsA(UStaticMesh::StaticClass()))
 		{
-			Extent = Cast<UStaticMesh>(Entry.Key)->GetBoundingBox().GetExtent();
 			CurrentSizeX = Cast<UStaticMesh>(Entry.Key)->GetBoundingBox().GetExtent().X;
 		}
 
 		// TODO : Handle Actors being used as openings
 
 		
-		for (const auto Opening : Entry.Value.Openings)
+		for (const auto& Opening : Entry.Value.Openings)
 		{
 			if(!Opening.bShouldApplyBoolean) continue;
 
 			if(!Opening.Mesh) continue;
 
-			auto* ComputeMesh = AllocateComputeMesh();
-			ComputeMesh->Reset();
-
-			/*float CurrentSizeX = Opening.Mesh->GetActorRelativeScale3D().X;
-
-			FVector Origin;
-			FVector Extent;
-			Opening.Mesh->GetActorBounds(false, Origin, Extent);
-
-			CurrentSizeX = Extent.X;*/
-
 			float ScaleOffset = .35f;
 			if (WallThickness > CurrentSizeX)
 			{
@@ -639,26 +814,31 @@ void APCG_BuildingGenerator::AppendOpeningToMesh(UDynamicMesh* TargetMesh)
 			}
 
 			const float Offset = Opening.bShouldCutHoleInTargetMesh ? ScaleOffset : 0.f;
-		
-			ComputeMesh = UHandyManModelingUtilities::CreateDynamicBooleanMesh(ComputeMesh, Opening.Mesh, Opening.BooleanShape, Offset , nullptr);
 
-			const auto RelativeTransform = UKismetMathLibrary::MakeRelativeTransform(Opening.Mesh->GetActorTransform(), GetActorTransform());
-			UGeometryScriptLibrary_MeshTransformFunctions::TransformMesh(ComputeMesh, RelativeTransform, false);
+			FBuildingOpeningCutter& Cutter = OutCutters.AddDefaulted_GetRef();
+			Cutter.Mesh = UHandyManModelingUtilities::GetCachedDynamicBooleanMesh(Opening.Mesh, Opening.BooleanShape, Offset);
+			Cutter.Transform = UKismetMathLibrary::MakeRelativeTransform(Opening.Mesh->GetActorTransform(), GetActorTransform());
+			Cutter.bSubtract = Opening.bShouldCutHoleInTargetMesh;
+		}
+	}
+}
 
-			UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(Booleans, ComputeMesh, FTransform::Identity);
-			// Cut this mesh from the target mesh
-			FGeometryScriptMeshBooleanOptions BooleanOptions;
-			BooleanOptions.bFillHoles = false;
-		
-			UGeometryScriptLibrary_MeshBooleanFunctions::ApplyMeshBoolean
-			(
-				TargetMesh,
-				FTransform::Identity,
-				ComputeMesh,
-				FTransform::Identity,
-				Opening.bShouldCutHoleInTargetMesh ? EGeometryScriptBooleanOperation::Subtract : EGeometryScriptBooleanOperation::Union,
-				BooleanOptions
-			);
+void APCG_BuildingGenerator::ApplyOpeningFit()
+{
+	for (const auto& Entry : GeneratedOpenings)
+	{
+		FVector Extent = FVector::One();
+
+		if (Entry.Key.IsA(UStaticMesh::StaticClass()))
+		{
+			Extent = Cast<UStaticMesh>(Entry.Key)->GetBoundingBox().GetExtent();
+		}
+
+		for (const auto& Opening : Entry.Value.Openings)
+		{
+			if(!Opening.bShouldApplyBoolean) continue;
+
+			if(!Opening.Mesh) continue;
 
 			if (!Opening.bShouldCutHoleInTargetMesh && Opening.bShouldApplyBoolean)
 			{
@@ -700,17 +880,17 @@ void APCG_BuildingGenerator::AppendOpeningToMesh(UDynamicMesh* TargetMesh)
 
 				Opening.Mesh->GetRootComponent()->SetRelativeScale3D(MeshScale);
 			}
-
-			/*bool bDebugBooleanMeshes = true;
-
-			if (bDebugBooleanMeshes)
-			{
-				UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(TargetMesh, Booleans, UKismetMathLibrary::MakeRelativeTransform(Opening.Mesh->GetActorTransform(), GetActorTransform()));
-			}*/
 		}
 	}
+}
 
-	
+TUniquePtr<FBuildingOpeningsOp> APCG_BuildingGenerator::MakeOpeningsOp() const
+{
+	auto Op = MakeUnique<FBuildingOpeningsOp>();
+	Op->WallMesh = CachedWallMesh;
+	Op->RemainderMesh = CachedRemainderMesh;
+	GatherOpeningCutters(Op->Cutters);
+	return Op;
 }
 
 #if WITH_EDITOR
@@ -738,6 +918,14 @@ void APCG_BuildingGenerator::PostEditChangeProperty(struct FPropertyChangedEvent
 		SetDesiredFloorClearance(DesiredFloorClearance);
 	}
 }
+
+void APCG_BuildingGenerator::PostEditUndo()
+{
+	Super::PostEditUndo();
+
+	// The input mesh may have been restored, the cached floors can't be trusted anymore
+	InvalidateFloorSegments();
+}
 	
 #endif
 
@@ -780,6 +968,8 @@ void APCG_BuildingGenerator::SetHasOpenRoof(const bool HasOpenRoof)
 void APCG_BuildingGenerator::SetUseConsistentFloorMaterials(const bool UseConsistentFloorMaterials)
 {
 	bUseConsistentFloorMaterial = UseConsistentFloorMaterials;
+
+	// Changes the material slot of every floor, the floors that are affected get rebuilt
 	RerunConstructionScripts();
 }
 
@@ -832,6 +1022,7 @@ void APCG_BuildingGenerator::SetDesiredBuildingHeight(const float NewBuildingHei
 	FGeometryScriptMeshSelection Selection;
 	UGeometryScriptLibrary_MeshSelectionFunctions::SelectMeshElementsByNormalAngle(OriginalMesh, Selection);
 	OriginalMesh = UGeometryScriptLibrary_MeshTransformFunctions::TranslateMeshSelection(OriginalMesh, Selection, FVector(0, 0, Delta * multiplier));
+	InvalidateFloorSegments();
 	
 	CreateFloorAndRoofSplines();
 	
@@ -10,7 +10,31 @@
 #include "PCG_BuildingGenerator.generated.h"
 
 
+namespace UE::Geometry { class FDynamicMesh3; }
+class FBuildingOpeningsOp;
+struct FBuildingOpeningCutter;
 class UBuildingGeneratorOpeningData;
+
+/** Cached mesh of a single floor slab, reused across rebuilds until one of its inputs changes */
+struct FBuildingFloorSegment
+{
+	double Height = 0.0;
+	float Thickness = 0.f;
+	int32 MaterialID = 0;
+
+	// Paths were taken from the top of the extruded slab instead of its base
+	bool bPathsAfterExtrude = false;
+
+	TArray<FGeometryScriptPolyPath> Paths;
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> Mesh;
+
+	// Same slab, possibly at another height or in another material slot
+	bool HasSameShape(const float InThickness, const bool bInPathsAfterExtrude) const
+	{
+		return Mesh.IsValid() && Thickness == InThickness && bPathsAfterExtrude == bInPathsAfterExtrude;
+	}
+};
+
 /**
  *  This actor generates a building based on a block out mesh. The mesh generated is completely procedural and can be modified by changing the parameters in the PCG component.
  *  There is also the option to bake this mesh to a static mesh asset. Which should be done to reduce the overhead of the procedural generation.
@@ -51,6 +75,9 @@ public:
 	UFUNCTION(BlueprintCallable, Category="Handy Man")
 	void SetFloorMaterial(const int32 Floor, const TSoftObjectPtr<UMaterialInterface> Material);
 
+	/** Drops the cached floor slabs, the next rebuild generates every floor again */
+	void InvalidateFloorSegments();
+
 	UFUNCTION(BlueprintCallable, Category="Handy Man")
 	void SetNumberOfFloors(const int32 NewFloorCount);
 	
@@ -103,11 +130,20 @@ public:
 	
 	void AddGeneratedOpeningEntry(const FGeneratedOpening& Entry);
 	void RemoveGeneratedOpeningEntry(const FGeneratedOpening& Entry);
-	void UpdatedGeneratedOpenings(const TArray<FGeneratedOpening>& Entries);
+	void UpdatedGeneratedOpenings(const TArray<FGeneratedOpening>& Entries, const bool bRerunConstruction = true);
 
 	TArray<FGeneratedOpening> GetGeneratedOpenings(const UObject* Key) const;
 	TArray<FGeneratedOpening> GetGeneratedOpenings() const;
 	TMap<TObjectPtr<UObject>, FGeneratedOpeningArray> GetGeneratedOpeningsMap() const;
+
+	/** True once a full rebuild captured the walls and floors the openings op works from */
+	bool HasOpeningsSnapshot() const { return CachedWallMesh.IsValid(); }
+
+	/**
+	 *  Creates an op applying the current openings to the walls of the last full rebuild.
+	 *  Must be called on the game thread, the op itself can then run on any thread.
+	 */
+	TUniquePtr<FBuildingOpeningsOp> MakeOpeningsOp() const;
 	
 
 protected:
@@ -193,21 +229,43 @@ private:
 	UPROPERTY()
 	TObjectPtr<UBuildingGeneratorOpeningData> CachedOpeningData;
 
+	// Walls before openings and the floors/roof of the last full rebuild
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> CachedWallMesh;
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> CachedRemainderMesh;
+
+	// Top face of the input mesh moved down to ground level, every floor slab is extruded from it
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> CachedFloorProfile;
+	float CachedFloorProfileHeight = 0.f;
+
+	// Floor slabs by floor index, the roof uses RoofSegmentIndex
+	TMap<int32, FBuildingFloorSegment> FloorSegments;
+	static constexpr int32 RoofSegmentIndex = INDEX_NONE;
+
+	// Distinct floor materials of the last rebuild, slot 0 is the building material and these follow it
+	TArray<TSoftObjectPtr<UMaterialInterface>> FloorMaterialSlots;
+
 	
 	void CreateBaseSplinesFromPolyPaths(const TArray<FGeometryScriptPolyPath>& Paths);
 	void CreateFloorSplinesFromPolyPaths(const TArray<FGeometryScriptPolyPath>& Paths);
 	void GenerateRoofMesh(UDynamicMesh* TargetMesh);
 	
-	TArray<FGeometryScriptPolyPath> UseTopFaceForFloor(UDynamicMesh* TargetMesh, double FloorHeight, const bool bApplyAfterExtrude = false);
+	TArray<FGeometryScriptPolyPath> UseTopFaceForFloor(UDynamicMesh* TargetMesh, const int32 SegmentIndex, double FloorHeight, const bool bApplyAfterExtrude = false);
+	const UE::Geometry::FDynamicMesh3& GetFloorProfile();
+	TSoftObjectPtr<UMaterialInterface> GetFloorMaterial(const int32 SegmentIndex) const;
+	int32 GetFloorMaterialID(const int32 SegmentIndex);
+	void ApplyFloorMaterials();
 	void GenerateFloorMeshes(UDynamicMesh* TargetMesh);
 	void GenerateExteriorWalls(UDynamicMesh* TargetMesh);
 	void AppendOpeningToMesh(UDynamicMesh* TargetMesh);
+	void GatherOpeningCutters(TArray<FBuildingOpeningCutter>& OutCutters) const;
+	void ApplyOpeningFit();
 	void CreateFloorAndRoofSplines();
 
 public:
 
 #if WITH_EDITOR
 	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
+	virtual void PostEditUndo() override;
 #endif
 	
 	
@@ -0,0 +1,173 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BuildingOpeningsOp.h"
+
+#include "DynamicMeshEditor.h"
+#include "DynamicMesh/MeshTransforms.h"
+#include "Operations/MeshBoolean.h"
+#include "Operations/MeshSelfUnion.h"
+
+using namespace UE::Geometry;
+
+namespace BuildingOpeningsOpLocals
+{
+	static bool IsCancelled(const FProgressCancel* Progress)
+	{
+		return Progress && Progress->Cancelled();
+	}
+
+	static void AppendMesh(FDynamicMesh3& TargetMesh, const FDynamicMesh3& MeshToAppend)
+	{
+		if (MeshToAppend.TriangleCount() == 0)
+		{
+			return;
+		}
+
+		TargetMesh.EnableMatchingAttributes(MeshToAppend, false);
+
+		FMeshIndexMappings Mappings;
+		FDynamicMeshEditor Editor(&TargetMesh);
+		Editor.AppendMesh(&MeshToAppend, Mappings);
+	}
+
+	static bool HasOverlappingBounds(const TArray<FAxisAlignedBox3d>& Bounds)
+	{
+		for (int32 i = 0; i < Bounds.Num(); ++i)
+		{
+			for (int32 j = i + 1; j < Bounds.Num(); ++j)
+			{
+				if (Bounds[i].Intersects(Bounds[j]))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	// Applies every cutter merged into Cutter with one boolean against TargetMesh
+	static void ApplyMergedCutter(FDynamicMesh3& TargetMesh, FDynamicMesh3& Cutter, const TArray<FAxisAlignedBox3d>& CutterBounds, const FMeshBoolean::EBooleanOp Operation, FProgressCancel* Progress)
+	{
+		if (CutterBounds.Num() == 0)
+		{
+			return;
+		}
+
+		// Overlapping cutters leave internal faces in the merged mesh, weld them into a single closed shape first
+		if (HasOverlappingBounds(CutterBounds))
+		{
+			FMeshSelfUnion SelfUnion(&Cutter);
+			SelfUnion.Progress = Progress;
+			SelfUnion.bSimplifyAlongNewEdges = true;
+			SelfUnion.Compute();
+		}
+
+		if (IsCancelled(Progress))
+		{
+			return;
+		}
+
+		FDynamicMesh3 NewResultMesh;
+		FMeshBoolean Boolean(&TargetMesh, FTransformSRT3d::Identity(), &Cutter, FTransformSRT3d::Identity(), &NewResultMesh, Operation);
+		Boolean.Progress = Progress;
+		Boolean.bPutResultInInputSpace = true;
+		Boolean.bSimplifyAlongNewEdges = true;
+		Boolean.Compute();
+
+		if (IsCancelled(Progress))
+		{
+			return;
+		}
+
+		TargetMesh = MoveTemp(NewResultMesh);
+	}
+}
+
+void FBuildingOpeningsOp::CalculateResult(FProgressCancel* Progress)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FBuildingOpeningsOp::CalculateResult);
+	using namespace BuildingOpeningsOpLocals;
+
+	Result->Clear();
+
+	if (WallMesh)
+	{
+		*Result = *WallMesh;
+
+		const FAxisAlignedBox3d WallBounds = Result->GetBounds(true);
+
+		FDynamicMesh3 SubtractCutter;
+		SubtractCutter.EnableMatchingAttributes(*Result);
+		TArray<FAxisAlignedBox3d> SubtractBounds;
+
+		FDynamicMesh3 UnionCutter;
+		UnionCutter.EnableMatchingAttributes(*Result);
+		TArray<FAxisAlignedBox3d> UnionBounds;
+
+		// Additive openings that don't touch the walls, a union with them is just an append
+		FDynamicMesh3 DisjointAdditions;
+		DisjointAdditions.EnableMatchingAttributes(*Result);
+
+		for (const FBuildingOpeningCutter& Cutter : Cutters)
+		{
+			if (IsCancelled(Progress))
+			{
+				return;
+			}
+
+			if (!Cutter.Mesh)
+			{
+				continue;
+			}
+
+			FDynamicMesh3 CutterMesh(*Cutter.Mesh);
+			MeshTransforms::ApplyTransform(CutterMesh, FTransformSRT3d(Cutter.Transform), false);
+
+			const FAxisAlignedBox3d CutterBounds = CutterMesh.GetBounds(true);
+			const bool bTouchesWall = WallBounds.Intersects(CutterBounds);
+
+			if (Cutter.bSubtract)
+			{
+				// A cutter that doesn't reach the walls can't remove anything from them
+				if (bTouchesWall)
+				{
+					AppendMesh(SubtractCutter, CutterMesh);
+					SubtractBounds.Add(CutterBounds);
+				}
+			}
+			else if (bTouchesWall)
+			{
+				AppendMesh(UnionCutter, CutterMesh);
+				UnionBounds.Add(CutterBounds);
+			}
+			else
+			{
+				AppendMesh(DisjointAdditions, CutterMesh);
+			}
+		}
+
+		// Holes are cut first so additive openings placed over them stay intact
+		ApplyMergedCutter(*Result, SubtractCutter, SubtractBounds, FMeshBoolean::EBooleanOp::Difference, Progress);
+		ApplyMergedCutter(*Result, UnionCutter, UnionBounds, FMeshBoolean::EBooleanOp::Union, Progress);
+
+		if (IsCancelled(Progress))
+		{
+			return;
+		}
+
+		AppendMesh(*Result, DisjointAdditions);
+	}
+
+	if (RemainderMesh)
+	{
+		if (Result->TriangleCount() == 0)
+		{
+			*Result = *RemainderMesh;
+		}
+		else
+		{
+			AppendMesh(*Result, *RemainderMesh);
+		}
+	}
+}
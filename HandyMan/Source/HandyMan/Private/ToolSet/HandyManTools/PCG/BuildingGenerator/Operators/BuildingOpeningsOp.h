@@ -0,0 +1,38 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModelingOperators.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+/** Boolean mesh of a single opening. Transform moves it into the building's local space. */
+struct FBuildingOpeningCutter
+{
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> Mesh;
+
+	FTransform Transform = FTransform::Identity;
+
+	// Cut a hole in the walls, otherwise the cutter is merged into them
+	bool bSubtract = true;
+};
+
+/**
+ *  Applies every opening of a building to its exterior walls and appends the rest of the building.
+ *  Cutters are grouped by operation and merged so the walls only go through one boolean per group.
+ *  Doesn't touch any UObject so it can run on a background thread.
+ */
+class HANDYMAN_API FBuildingOpeningsOp : public UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>
+{
+public:
+
+	// Exterior walls before any opening is applied
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> WallMesh;
+
+	// Floors and roof, appended to the result as is
+	TSharedPtr<const UE::Geometry::FDynamicMesh3> RemainderMesh;
+
+	TArray<FBuildingOpeningCutter> Cutters;
+
+	virtual void CalculateResult(FProgressCancel* Progress) override;
+};
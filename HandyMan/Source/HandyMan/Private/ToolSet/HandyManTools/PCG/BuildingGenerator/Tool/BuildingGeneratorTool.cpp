@@ -7,6 +7,7 @@
 #include "Engine/StaticMeshActor.h"
 #include "ToolSet/HandyManTools/PCG/BuildingGenerator/Actor/PCG_BuildingGenerator.h"
 #include "ToolSet/HandyManTools/PCG/BuildingGenerator/DataAssets/BuildingGeneratorOpeningData.h"
+#include "ToolSet/HandyManTools/PCG/BuildingGenerator/Operators/BuildingOpeningsOp.h"
 
 #define LOCTEXT_NAMESPACE "BuildingGeneratorTool"
 
@@ -227,6 +228,16 @@ void UBuildingGeneratorTool::Setup()
 
 	
 	Settings->SilentUpdateWatched();
+
+	OpeningsCompute = MakeUnique<UE::Geometry::TGenericDataBackgroundCompute<UE::Geometry::FDynamicMesh3>>();
+	OpeningsCompute->Setup(this);
+	OpeningsCompute->OnResultUpdated.AddWeakLambda(this, [this](const TUniquePtr<UE::Geometry::FDynamicMesh3>& Result)
+	{
+		if (IsValid(OutputActor) && Result)
+		{
+			OutputActor->GetDynamicMeshComponent()->GetDynamicMesh()->SetMesh(*Result);
+		}
+	});
 	
 	if (TargetActor->IsA(APCG_BuildingGenerator::StaticClass()))
 	{
@@ -844,9 +855,17 @@ void UBuildingGeneratorTool::OnGizmoTransformChanged_Handler(FString GizmoIdenti
 		}
 		*/
 
-		UpdateOpeningTransforms(GizmoIdentifier, NewTransform);
-		OutputActor->RerunConstructionScripts();
-		
+		// Only the opening actors follow the gizmo, the building is rebuilt in the background and swapped in once ready
+		UpdateOpeningTransforms(GizmoIdentifier, NewTransform, false);
+
+		if (OpeningsCompute && OutputActor->HasOpeningsSnapshot())
+		{
+			OpeningsCompute->InvalidateResult();
+		}
+		else
+		{
+			OutputActor->RerunConstructionScripts();
+		}
 	}
 	
 }
@@ -888,8 +907,9 @@ void UBuildingGeneratorTool::OnGizmoTransformStateChange_Handler(FString GizmoId
 
 	if (ChangeType == EScriptableToolGizmoStateChangeType::EndTransform || ChangeType == EScriptableToolGizmoStateChangeType::UndoRedo)
 	{
-	
-		UpdateOpeningTransforms(GizmoIdentifier, CurrentTransform);
+		// The full rebuild replaces any preview still in flight
+		CancelOpeningsCompute();
+		UpdateOpeningTransforms(GizmoIdentifier, CurrentTransform, false);
 		bIsCopying = false;
 		OutputActor->RerunConstructionScripts();
 	}
@@ -898,7 +918,7 @@ void UBuildingGeneratorTool::OnGizmoTransformStateChange_Handler(FString GizmoId
 
 }
 
-void UBuildingGeneratorTool::UpdateOpeningTransforms(const FString& GizmoIdentifier, const FTransform& CurrentTransform)
+void UBuildingGeneratorTool::UpdateOpeningTransforms(const FString& GizmoIdentifier, const FTransform& CurrentTransform, const bool bRerunConstruction)
 {
 	if (!bIsEditing)
 	{
@@ -921,7 +941,7 @@ void UBuildingGeneratorTool::UpdateOpeningTransforms(const FString& GizmoIdentif
 			}
 		}
 
-		OutputActor->UpdatedGeneratedOpenings(CachedOpenings.Openings);
+		OutputActor->UpdatedGeneratedOpenings(CachedOpenings.Openings, bRerunConstruction);
 	}
 	else
 	{
@@ -944,7 +964,25 @@ void UBuildingGeneratorTool::UpdateOpeningTransforms(const FString& GizmoIdentif
 			}
 		}
 
-		OutputActor->UpdatedGeneratedOpenings(EditedOpenings.Openings);
+		OutputActor->UpdatedGeneratedOpenings(EditedOpenings.Openings, bRerunConstruction);
+	}
+}
+
+TUniquePtr<UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>> UBuildingGeneratorTool::MakeNewOperator()
+{
+	if (!IsValid(OutputActor))
+	{
+		return MakeUnique<FBuildingOpeningsOp>();
+	}
+	
+	return OutputActor->MakeOpeningsOp();
+}
+
+void UBuildingGeneratorTool::CancelOpeningsCompute()
+{
+	if (OpeningsCompute)
+	{
+		OpeningsCompute->Cancel();
 	}
 }
 
@@ -1206,6 +1244,11 @@ void UBuildingGeneratorTool::ResetBrush()
 void UBuildingGeneratorTool::OnTick(float DeltaTime)
 {
 	Super::OnTick(DeltaTime);
+
+	if (OpeningsCompute)
+	{
+		OpeningsCompute->Tick(DeltaTime);
+	}
 	
 	DrawDebugLine(GetWorld(), BrushPosition, (BrushPosition + BrushDirection), BrushColor.ToFColor(false), false, -1, 0, 5);
 
@@ -1222,6 +1265,9 @@ void UBuildingGeneratorTool::Shutdown(EToolShutdownType ShutdownType)
 {
 	Super::Shutdown(ShutdownType);
 
+	CancelOpeningsCompute();
+	OpeningsCompute.Reset();
+
 	switch (ShutdownType)
 	{
 	case EToolShutdownType::Completed:
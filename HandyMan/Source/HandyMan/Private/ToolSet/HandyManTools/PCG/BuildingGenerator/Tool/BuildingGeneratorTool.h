@@ -3,6 +3,8 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "BackgroundModelingComputeSource.h"
+#include "ModelingOperators.h"
 #include "Behaviors/ScriptableToolBehaviorDelegates.h"
 #include "ToolSet/HandyManBaseClasses/HandyManModularTool.h"
 #include "ToolSet/HandyManBaseClasses/HandyManSingleClickTool.h"
@@ -18,7 +20,7 @@ class UBuildingGeneratorPropertySet;
  * 
  */
 UCLASS()
-class HANDYMAN_API UBuildingGeneratorTool : public UHandyManModularTool
+class HANDYMAN_API UBuildingGeneratorTool : public UHandyManModularTool, public UE::Geometry::IGenericDataOperatorFactory<UE::Geometry::FDynamicMesh3>
 {
 	GENERATED_BODY()
 
@@ -89,7 +91,10 @@ public:
 	virtual void OnGizmoTransformStateChange_Handler(FString GizmoIdentifier, FTransform CurrentTransform, EScriptableToolGizmoStateChangeType ChangeType) override;
 	virtual void OnGizmoTransformChanged_Handler(FString GizmoIdentifier, FTransform NewTransform) override;
 	
-	void UpdateOpeningTransforms(const FString& GizmoIdentifier, const FTransform& CurrentTransform);
+	void UpdateOpeningTransforms(const FString& GizmoIdentifier, const FTransform& CurrentTransform, const bool bRerunConstruction = true);
+
+	///~ IGenericDataOperatorFactory API
+	virtual TUniquePtr<UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>> MakeNewOperator() override;
 
 
 	bool bCanSpawn = false;
@@ -231,6 +236,11 @@ private:
 	UPROPERTY()
 	FVector CopiedScale = FVector::ZeroVector;
 
+	/** Rebuilds the building's openings in the background while a gizmo is dragged */
+	TUniquePtr<UE::Geometry::TGenericDataBackgroundCompute<UE::Geometry::FDynamicMesh3>> OpeningsCompute;
+
+	void CancelOpeningsCompute();
+
 	
 };
 
@@ -3,6 +3,8 @@
 
 #include "ToolSet/HandyManTools/PCG/Core/Actors/PCG_DynamicMeshActor_Runtime.h"
 
+#include "TimerManager.h"
+
 
 // Sets default values
 APCG_DynamicMeshActor_Runtime::APCG_DynamicMeshActor_Runtime()
@@ -12,6 +14,8 @@ APCG_DynamicMeshActor_Runtime::APCG_DynamicMeshActor_Runtime()
 
 	if (DynamicMeshComponent)
 	{
+		// The component would cook on every change, collision goes through FlushCollisionUpdate instead
+		DynamicMeshComponent->bDeferCollisionUpdates = true;
 		MeshObjectChangedHandle = DynamicMeshComponent->GetDynamicMesh()->OnMeshChanged().AddUObject(this, &APCG_DynamicMeshActor_Runtime::OnMeshObjectChanged);
 	}
 }
@@ -27,6 +31,8 @@ void APCG_DynamicMeshActor_Runtime::BeginPlay()
 void APCG_DynamicMeshActor_Runtime::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	FlushPendingCollisionUpdate();
 }
 
 void APCG_DynamicMeshActor_Runtime::SetCollisionProfileByName(const FName ProfileName)
@@ -35,14 +41,52 @@ void APCG_DynamicMeshActor_Runtime::SetCollisionProfileByName(const FName Profil
 	DynamicMeshComponent->SetCollisionProfileName(CollisionProfileName);
 }
 
-void APCG_DynamicMeshActor_Runtime::OnMeshObjectChanged(UDynamicMesh* ChangedMeshObject, FDynamicMeshChangeInfo ChangeInfo)
+void APCG_DynamicMeshActor_Runtime::SuspendCollisionUpdates()
 {
+	++CollisionSuspendCount;
+}
+
+void APCG_DynamicMeshActor_Runtime::ResumeCollisionUpdates()
+{
+	ensure(CollisionSuspendCount > 0);
+	CollisionSuspendCount = FMath::Max(CollisionSuspendCount - 1, 0);
+
+	FlushPendingCollisionUpdate();
+}
+
+void APCG_DynamicMeshActor_Runtime::FlushCollisionUpdate()
+{
+	bCollisionUpdatePending = false;
+	
 	// Update the collision settings for this mesh
 	if (DynamicMeshComponent)
 	{
-		DynamicMeshComponent->UpdateCollision();
+		DynamicMeshComponent->bUseAsyncCooking = bUseAsyncCollisionCooking;
+		DynamicMeshComponent->UpdateCollision(false);
 		DynamicMeshComponent->SetCollisionProfileName(CollisionProfileName);
 	}
-	
+}
+
+void APCG_DynamicMeshActor_Runtime::FlushPendingCollisionUpdate()
+{
+	if (bCollisionUpdatePending && CollisionSuspendCount == 0)
+	{
+		FlushCollisionUpdate();
+	}
+}
+
+void APCG_DynamicMeshActor_Runtime::OnMeshObjectChanged(UDynamicMesh* ChangedMeshObject, FDynamicMeshChangeInfo ChangeInfo)
+{
+	if (bCollisionUpdatePending)
+	{
+		return;
+	}
+	bCollisionUpdatePending = true;
+
+	// Subclasses may not tick, so the cook does not rely on Tick being called
+	if (const UWorld* World = GetWorld())
+	{
+		World->GetTimerManager().SetTimerForNextTick(this, &APCG_DynamicMeshActor_Runtime::FlushPendingCollisionUpdate);
+	}
 }
 
@@ -31,14 +31,66 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "PCG")
 	void SetCollisionProfileByName(const FName ProfileName);
 
+	/** Holds back collision updates during a multi-step build, each call needs a matching ResumeCollisionUpdates */
+	UFUNCTION(BlueprintCallable, Category = "PCG")
+	void SuspendCollisionUpdates();
+
+	/** Releases a suspension, the changes made meanwhile are cooked once the last suspension is released */
+	UFUNCTION(BlueprintCallable, Category = "PCG")
+	void ResumeCollisionUpdates();
+
+	/** Starts cooking the pending collision right away instead of at the next tick */
+	UFUNCTION(BlueprintCallable, Category = "PCG")
+	void FlushCollisionUpdate();
+
+	// Pending collision is also cooked from Tick, editor viewports included
+	virtual bool ShouldTickIfViewportsOnly() const override { return bCollisionUpdatePending; }
+
 protected:
 
 	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Dynamic Mesh", meta=(GetOptions="HandyMan.HandyManStatics.GetCollisionProfileNames"))
 	FName CollisionProfileName = FName(TEXT("BlockAll"));
+
+	/* Cooks collision off the game thread, the previous collision stays in use until the new one is ready */
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category="Dynamic Mesh")
+	bool bUseAsyncCollisionCooking = true;
 	
 	
 	/** Handle for OnMeshObjectChanged which is registered with MeshObject::OnMeshChanged delegate */
 	FDelegateHandle MeshObjectChangedHandle;
 
 	virtual void OnMeshObjectChanged(UDynamicMesh* ChangedMeshObject, FDynamicMeshChangeInfo ChangeInfo);
+
+	// Cooks the pending collision unless updates are suspended, scheduled for the next tick on every change
+	void FlushPendingCollisionUpdate();
+
+	// Mesh changes only mark the collision dirty, it is cooked once per frame at most
+	bool bCollisionUpdatePending = false;
+	int32 CollisionSuspendCount = 0;
+};
+
+/* Suspends the collision updates of an actor for the lifetime of the scope */
+struct FPCGCollisionUpdateScope
+{
+	explicit FPCGCollisionUpdateScope(APCG_DynamicMeshActor_Runtime* InActor)
+		: Actor(InActor)
+	{
+		if (Actor)
+		{
+			Actor->SuspendCollisionUpdates();
+		}
+	}
+
+	~FPCGCollisionUpdateScope()
+	{
+		if (Actor)
+		{
+			Actor->ResumeCollisionUpdates();
+		}
+	}
+
+	UE_NONCOPYABLE(FPCGCollisionUpdateScope);
+
+private:
+	APCG_DynamicMeshActor_Runtime* Actor;
 };
@@ -0,0 +1,50 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "PCGNavGraphData.h"
+
+#include "Data/PCGPointData.h"
+#include "Serialization/ArchiveCrc32.h"
+#include "ToolSet/Algorithms/AStarPathFinding/PCGPathfindHelper.h"
+
+void UPCGNavGraphData::AddToCrc(FArchiveCrc32& Ar, bool bFullDataCrc) const
+{
+	Super::AddToCrc(Ar, bFullDataCrc);
+
+	// The graph is fully determined by the points it was built from
+	uint32 Crc = SourceCrc;
+	Ar << Crc;
+}
+
+void UPCGNavGraphData::Initialize(FPathfindGraph&& InGraph, const UPCGPointData* InSourceData, uint32 InSourceCrc)
+{
+	Graph = MoveTemp(InGraph);
+	SourceData = InSourceData;
+	SourceCrc = InSourceCrc;
+}
+
+TSharedPtr<const FPathfindHierarchy> UPCGNavGraphData::GetOrBuildHierarchy(float ClusterSize, int32 PortalsPerBoundary) const
+{
+	const bool bClusterSizeIsAuto = ClusterSize <= 0.f;
+	{
+		FScopeLock Lock(&HierarchyLock);
+
+		// A cluster size of 0 is resolved while building, compare against what was actually requested
+		const bool bSameClusterSize = Hierarchy && (bClusterSizeIsAuto ? bHierarchyClusterSizeWasAuto : FMath::IsNearlyEqual(Hierarchy->ClusterSize, ClusterSize));
+		if (bSameClusterSize && Hierarchy->IsBuiltFor(Graph) && HierarchyPortalsPerBoundary == PortalsPerBoundary)
+		{
+			return Hierarchy;
+		}
+	}
+
+	// Built outside the lock, queries still reading the previous hierarchy keep their own reference to it
+	TSharedPtr<FPathfindHierarchy> NewHierarchy = MakeShared<FPathfindHierarchy>();
+	UPCGPathfindHelper::BuildHierarchy(Graph, ClusterSize, PortalsPerBoundary, *NewHierarchy);
+
+	FScopeLock Lock(&HierarchyLock);
+	Hierarchy = NewHierarchy;
+	HierarchyPortalsPerBoundary = PortalsPerBoundary;
+	bHierarchyClusterSizeWasAuto = bClusterSizeIsAuto;
+
+	return NewHierarchy;
+}
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PCGData.h"
+#include "ToolSet/Algorithms/AStarPathFinding/PathfindGraph.h"
+#include "PCGNavGraphData.generated.h"
+
+class UPCGPointData;
+
+/**
+ * Navigation graph built from a point set, in CSR layout with per-edge costs.
+ * Produced by the Build Nav Graph node and consumed by the A Star Path Finding node so the
+ * connectivity isn't recomputed for every query.
+ */
+UCLASS(BlueprintType, ClassGroup = (HandyMan))
+class HANDYMAN_API UPCGNavGraphData : public UPCGData
+{
+	GENERATED_BODY()
+
+public:
+	//~Begin UPCGData interface
+	virtual EPCGDataType GetDataType() const override { return EPCGDataType::Other; }
+	virtual void AddToCrc(FArchiveCrc32& Ar, bool bFullDataCrc) const override;
+	//~End UPCGData interface
+
+	void Initialize(FPathfindGraph&& InGraph, const UPCGPointData* InSourceData, uint32 InSourceCrc);
+
+	/** Point data the graph was built from, its nodes share the same indices */
+	const UPCGPointData* GetSourceData() const { return SourceData; }
+
+	const FPathfindGraph& GetGraph() const { return Graph; }
+
+	/**
+	 * Hierarchy over the graph for HPA* queries, built on first use and reused while the parameters don't change.
+	 * A rebuild swaps in a new hierarchy, the snapshot handed out stays valid for as long as the caller holds it.
+	 */
+	TSharedPtr<const FPathfindHierarchy> GetOrBuildHierarchy(float ClusterSize, int32 PortalsPerBoundary) const;
+
+	/** Crc of the point data the graph was built from */
+	uint32 GetSourceCrc() const { return SourceCrc; }
+
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	int32 GetNumNodes() const { return Graph.Num(); }
+
+	UFUNCTION(BlueprintCallable, Category = "Navigation")
+	int32 GetNumEdges() const { return Graph.AdjacencyIndices.Num(); }
+
+protected:
+	FPathfindGraph Graph;
+
+	UPROPERTY()
+	TObjectPtr<const UPCGPointData> SourceData;
+
+	uint32 SourceCrc = 0;
+
+	mutable FCriticalSection HierarchyLock;
+	mutable TSharedPtr<const FPathfindHierarchy> Hierarchy;
+	mutable int32 HierarchyPortalsPerBoundary = 0;
+	mutable bool bHierarchyClusterSizeWasAuto = false;
+};
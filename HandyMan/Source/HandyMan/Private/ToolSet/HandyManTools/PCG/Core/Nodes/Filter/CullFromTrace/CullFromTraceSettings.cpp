@@ -6,6 +6,7 @@
 #include "PCGComponent.h"
 #include "PCGContext.h"
 #include "Data/PCGPointData.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "PCGWorldQuery_SphereTrace"
 namespace PCGCullSettings
@@ -49,12 +50,23 @@ FPCGElementPtr UCullFromTraceSettings::CreateElement() const
 	return MakeShared<FPCGCullPointsElement>();
 }
 
+FPCGContext* FPCGCullPointsElement::Initialize(const FPCGDataCollection& InputData, TWeakObjectPtr<UPCGComponent> SourceComponent, const UPCGNode* Node)
+{
+	FPCGCullPointsContext* Context = new FPCGCullPointsContext();
+	Context->InputData = InputData;
+	Context->SourceComponent = SourceComponent;
+	Context->Node = Node;
+
+	return Context;
+}
+
 /// ---------------------------------------------------------
 /// POINT LOOP
-bool FPCGCullPointsElement::ExecuteInternal(FPCGContext* Context) const
+bool FPCGCullPointsElement::ExecuteInternal(FPCGContext* InContext) const
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGFilterBySeedValueElement::Execute);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGCullPointsElement::Execute);
 
+	FPCGCullPointsContext* Context = static_cast<FPCGCullPointsContext*>(InContext);
 	check(Context);
 
 	const UCullFromTraceSettings* Settings = Context->GetInputSettings<UCullFromTraceSettings>();
@@ -65,35 +77,54 @@ bool FPCGCullPointsElement::ExecuteInternal(FPCGContext* Context) const
 	const UWorld* World = Context->SourceComponent.Get()->GetWorld();
 	check(World);
 
-	for (const FPCGTaggedData& Input : Context->InputData.GetInputsByPin(FName("Source")))
+	if (!Context->bInitialized)
 	{
+		for (const auto& Type : Settings->ChannelsToTrace)
+		{
+			Context->ObjectQueryParams.AddObjectTypesToQuery(Type);
+		}
+
+		Context->SourceInputs = Context->InputData.GetInputsByPin(FName("Source"));
+		Context->bInitialized = true;
+	}
+
+	while (Context->CurrentInputIndex < Context->SourceInputs.Num())
+	{
+		const FPCGTaggedData& Input = Context->SourceInputs[Context->CurrentInputIndex];
 		const UPCGPointData* PointData = Cast<UPCGPointData>(Input.Data);
 
 		if (!PointData)
 		{
 			PCGE_LOG(Error, GraphAndLog, LOCTEXT("InputNotPointData", "Input is not a point data"));
+			++Context->CurrentInputIndex;
 			continue;
 		}
 
 		const TArray<FPCGPoint>& InPoints = PointData->GetPoints();
-		
-		// Create output point data. This is the recommended way instead of writing directly to the incoming points.
-		UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
-		ChosenPointsData->InitializeFromData(PointData);
-		TArray<FPCGPoint>& ChosenPoints = ChosenPointsData->GetMutablePoints();
+		if (Context->CurrentPointIndex == 0)
+		{
+			Context->ChosenCounts.Init(0, InPoints.Num());
+			Context->CulledCounts.Init(0, InPoints.Num());
+		}
 
-		UPCGPointData* CulledPointsData = NewObject<UPCGPointData>();
-		CulledPointsData->InitializeFromData(PointData);
-		TArray<FPCGPoint>& CulledPoints = CulledPointsData->GetMutablePoints();
-		
-		TArray<FHitResult> OutHits;
-        
-		for (int i =0; i < InPoints.Num(); i++)
+		// Sweep the points in parallel batches and give the frame back once the time budget is spent
+		while (Context->CurrentPointIndex < InPoints.Num())
 		{
-			FPCGPoint AlteredPoint = InPoints[i]; 
-			FVector TraceLocation = InPoints[i].Transform.GetLocation();
-			if (Trace(World, TraceLocation, TraceLocation, Settings->ChannelsToTrace, Settings->SphereRadius, OutHits))
+			const int32 BatchStart = Context->CurrentPointIndex;
+			const int32 BatchEnd = FMath::Min(BatchStart + PointsPerBatch, InPoints.Num());
+
+			ParallelFor(BatchEnd - BatchStart, [this, Context, Settings, World, &InPoints, BatchStart](int32 BatchIndex)
 			{
+				const int32 i = BatchStart + BatchIndex;
+				TArray<FHitResult> OutHits;
+
+				FVector TraceLocation = InPoints[i].Transform.GetLocation();
+				if (!Trace(World, TraceLocation, TraceLocation, Context->ObjectQueryParams, Settings->SphereRadius, OutHits))
+				{
+					Context->ChosenCounts[i] = 1;
+					return;
+				}
+
 				for (const auto& Hit : OutHits)
 				{
 					const auto* HitActor = Hit.GetActor();
@@ -103,28 +134,52 @@ bool FPCGCullPointsElement::ExecuteInternal(FPCGContext* Context) const
 					{
 						if (ContainsAny(HitActor->Tags, Settings->ActorTagsToCull))
 						{
-							CulledPoints.Add(AlteredPoint);
+							++Context->CulledCounts[i];
 							continue;
 						}
 						
 						if (IsValid(HitComponent) && ContainsAny(HitComponent->ComponentTags, Settings->ComponentTagsToCull))
 						{
-							CulledPoints.Add(AlteredPoint);
+							++Context->CulledCounts[i];
 							continue;
 						}
 					}
 
 					if(Hit.Normal.Equals(FVector::UpVector)) continue;
-					ChosenPoints.Add(AlteredPoint);
+					++Context->ChosenCounts[i];
 				}
+			});
+
+			Context->CurrentPointIndex = BatchEnd;
+
+			if (Context->CurrentPointIndex < InPoints.Num() && Context->ShouldStop())
+			{
+				return false;
+			}
+		}
+
+		// Create output point data. This is the recommended way instead of writing directly to the incoming points.
+		UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
+		ChosenPointsData->InitializeFromData(PointData);
+		TArray<FPCGPoint>& ChosenPoints = ChosenPointsData->GetMutablePoints();
+
+		UPCGPointData* CulledPointsData = NewObject<UPCGPointData>();
+		CulledPointsData->InitializeFromData(PointData);
+		TArray<FPCGPoint>& CulledPoints = CulledPointsData->GetMutablePoints();
+
+		for (int i =0; i < InPoints.Num(); i++)
+		{
+			for (int32 k = 0; k < Context->CulledCounts[i]; ++k)
+			{
+				CulledPoints.Add(InPoints[i]);
 			}
-			else
+
+			for (int32 k = 0; k < Context->ChosenCounts[i]; ++k)
 			{
-				ChosenPoints.Add(AlteredPoint);
+				ChosenPoints.Add(InPoints[i]);
 			}
 		}
         
-        
 		// Output all in output collection
 		FPCGTaggedData& ChosenTaggedData = Outputs.Add_GetRef(Input);
 		ChosenTaggedData.Data = ChosenPointsData;
@@ -134,22 +189,22 @@ bool FPCGCullPointsElement::ExecuteInternal(FPCGContext* Context) const
 		CulledTaggedData.Data = CulledPointsData;
 		CulledTaggedData.Pin = PCGCullSettings::RemovedPointsLabel;
 
-		
+		++Context->CurrentInputIndex;
+		Context->CurrentPointIndex = 0;
+
+		if (Context->CurrentInputIndex < Context->SourceInputs.Num() && Context->ShouldStop())
+		{
+			return false;
+		}
 	}
 
 	return true;
 }
 
-bool FPCGCullPointsElement::Trace(const UWorld* World, const FVector& Start, const FVector& End, const TArray<TEnumAsByte<ECollisionChannel>>& Types, const float& Radius, TArray<FHitResult>& OutHits) const
+bool FPCGCullPointsElement::Trace(const UWorld* World, const FVector& Start, const FVector& End, const FCollisionObjectQueryParams& Params, const float& Radius, TArray<FHitResult>& OutHits) const
 {
 	if (!World) return false;
 
-	FCollisionObjectQueryParams Params;
-	for (const auto& Type : Types)
-	{
-		Params.AddObjectTypesToQuery(Type);
-	}
-    
 	return World->SweepMultiByObjectType(OutHits, Start, End, FQuat::Identity, Params, FCollisionShape::MakeSphere(Radius));
 }
 
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "PCGSettings.h"
+#include "PCGContext.h"
+#include "CollisionQueryParams.h"
 #include "CullFromTraceSettings.generated.h"
 
 /**
@@ -52,15 +54,36 @@ public:
 	
 };
 
+struct FPCGCullPointsContext : public FPCGContext
+{
+	bool bInitialized = false;
+
+	// Built once per execution instead of once per trace
+	FCollisionObjectQueryParams ObjectQueryParams;
+
+	// Progress through the Source inputs, kept across frames when the execution is time sliced
+	TArray<FPCGTaggedData> SourceInputs;
+	int32 CurrentInputIndex = 0;
+	int32 CurrentPointIndex = 0;
+
+	// How many times every point of the current input lands in each output, one entry per hit that classified it
+	TArray<uint16> ChosenCounts;
+	TArray<uint16> CulledCounts;
+};
+
 class FPCGCullPointsElement : public IPCGElement
 {
+public:
+	virtual FPCGContext* Initialize(const FPCGDataCollection& InputData, TWeakObjectPtr<UPCGComponent> SourceComponent, const UPCGNode* Node) override;
+
 protected:
 	virtual bool ExecuteInternal(FPCGContext* Context) const override;
 
-	bool Trace(const UWorld* World, const FVector& Start, const FVector& End,  const TArray<TEnumAsByte<ECollisionChannel>>& Types, const float& Radius, TArray<FHitResult>& OutHits) const;
+	bool Trace(const UWorld* World, const FVector& Start, const FVector& End, const FCollisionObjectQueryParams& Params, const float& Radius, TArray<FHitResult>& OutHits) const;
 
 	bool ContainsAny(const TArray<FName>& Array, const TArray<FName>& Compare) const;
 
-	// Cache the seed value of the selected points so there are no duplicates
+	// Number of points traced per parallel batch, the time budget is checked between batches
+	static constexpr int32 PointsPerBatch = 1024;
 };
 
@@ -5,6 +5,8 @@
 #include "PCGContext.h"
 #include "Data/PCGPointData.h"
 #include "ToolSet/Algorithms/AStarPathFinding/PCGPathfindHelper.h"
+#include "ToolSet/HandyManTools/PCG/Core/Data/PCGNavGraphData.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "PCGGroupRandomPairsSettings"
 
@@ -16,6 +18,20 @@ namespace PCGPathFindingSettings
     static const FName StartingPointLabel = TEXT("StartPoint");
     static const FName EndingPointLabel = TEXT("EndPoint");
     static const FName PathPointsLabel = TEXT("PathPoints");
+    static const FName NavGraphLabel = TEXT("NavGraph");
+
+    static const FString StartSeedTag = TEXT("StartSeed");
+    static const FString EndSeedTag = TEXT("EndSeed");
+
+    static void WritePathPoints(const FPathfindGraph& Graph, const TArray<int32>& PathIndices, TArray<FPCGPoint>& OutPoints)
+    {
+        OutPoints.Reserve(OutPoints.Num() + PathIndices.Num());
+        for (const int32 NodeIndex : PathIndices)
+        {
+            FPCGPoint& NewPoint = OutPoints.Emplace_GetRef();
+            NewPoint.Transform.SetLocation(Graph.Positions[NodeIndex]);
+        }
+    }
     
 }
 
@@ -36,6 +52,9 @@ TArray<FPCGPinProperties> UPathFinding_AStarSettings::InputPinProperties() const
     Properties.Emplace(PCGPathFindingSettings::EndingPointLabel, EPCGDataType::Point);
     Properties.Emplace(PCGPathFindingSettings::PathPointsLabel, EPCGDataType::Point);
 
+    FPCGPinProperties& NavGraphPin = Properties.Emplace_GetRef(PCGPathFindingSettings::NavGraphLabel, EPCGDataType::Other);
+    NavGraphPin.Tooltip = LOCTEXT("NavGraphTooltip", "Optional graph from the Build Nav Graph node. When connected it is used instead of connecting the path points again.");
+
     return Properties;
 }
 
@@ -66,20 +85,139 @@ bool FPCGAStarPathfindingElement::ExecuteInternal(FPCGContext* Context) const
 
     TArray<FPCGTaggedData>& Outputs = Context->OutputData.TaggedData;
 
-    const FPCGPoint& StartingPoint = Cast<UPCGPointData>(Context->InputData.GetInputsByPin(PCGPathFindingSettings::StartingPointLabel)[0].Data)->GetPoint(0);
-    const FPCGPoint& EndingPoint = Cast<UPCGPointData>(Context->InputData.GetInputsByPin(PCGPathFindingSettings::EndingPointLabel)[0].Data)->GetPoint(0);
-    const TArray<FPCGPoint>& PathPoints = Cast<UPCGPointData>(Context->InputData.GetInputsByPin(PCGPathFindingSettings::PathPointsLabel)[0].Data)->GetPoints();
-
-    const TArray<FPCGPoint>& NewPoints = UPCGPathfindHelper::FindPath(StartingPoint, EndingPoint, PathPoints);
-
-    UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
-    ChosenPointsData->InitializeFromData(Cast<UPCGPointData>(Context->InputData.GetInputs()[2].Data));
-    ChosenPointsData->SetPoints(NewPoints);
-   
-    // Output all in output collection
-    FPCGTaggedData& ChosenTaggedData = Outputs.Add_GetRef(Context->InputData.GetInputs()[1]);
-    ChosenTaggedData.Data = ChosenPointsData;
-    ChosenTaggedData.Pin = PCGPathFindingSettings::FinalPointsLabel;
+    const TArray<FPCGTaggedData> StartInputs = Context->InputData.GetInputsByPin(PCGPathFindingSettings::StartingPointLabel);
+    const TArray<FPCGTaggedData> EndInputs = Context->InputData.GetInputsByPin(PCGPathFindingSettings::EndingPointLabel);
+    const TArray<FPCGTaggedData> PathInputs = Context->InputData.GetInputsByPin(PCGPathFindingSettings::PathPointsLabel);
+
+    const TArray<FPCGTaggedData> NavGraphInputs = Context->InputData.GetInputsByPin(PCGPathFindingSettings::NavGraphLabel);
+
+    const UPCGPointData* PathPointsData = PathInputs.Num() > 0 ? Cast<UPCGPointData>(PathInputs[0].Data) : nullptr;
+    const UPCGNavGraphData* NavGraphData = NavGraphInputs.Num() > 0 ? Cast<UPCGNavGraphData>(NavGraphInputs[0].Data) : nullptr;
+    if ((!PathPointsData && !NavGraphData) || StartInputs.IsEmpty() || EndInputs.IsEmpty())
+    {
+        PCGE_LOG(Error, GraphAndLog, LOCTEXT("MissingInputs", "Start and end points are required, along with either path points or a nav graph"));
+        return true;
+    }
+
+    // A prebuilt nav graph skips the connectivity pass entirely, otherwise it is built once for every pair
+    FPathfindGraph LocalGraph;
+    if (!NavGraphData)
+    {
+        UPCGPathfindHelper::BuildGraph(PathPointsData->GetPoints(), LocalGraph);
+    }
+    const FPathfindGraph& Graph = NavGraphData ? NavGraphData->GetGraph() : LocalGraph;
+
+    // Output points carry the metadata of the points the graph was built from
+    const UPCGPointData* GraphSourceData = NavGraphData ? NavGraphData->GetSourceData() : PathPointsData;
+
+    // The nav graph keeps its hierarchy around between executions, a local graph builds a throwaway one
+    FPathfindHierarchy LocalHierarchy;
+    TSharedPtr<const FPathfindHierarchy> SharedHierarchy;
+    const FPathfindHierarchy* Hierarchy = nullptr;
+    if (Settings->bUseHierarchicalSearch)
+    {
+        if (NavGraphData)
+        {
+            SharedHierarchy = NavGraphData->GetOrBuildHierarchy(Settings->ClusterSize, Settings->PortalsPerBoundary);
+            Hierarchy = SharedHierarchy.Get();
+        }
+        else
+        {
+            UPCGPathfindHelper::BuildHierarchy(Graph, Settings->ClusterSize, Settings->PortalsPerBoundary, LocalHierarchy);
+            Hierarchy = &LocalHierarchy;
+        }
+    }
+
+    if (!Settings->bBatchMode)
+    {
+        const UPCGPointData* StartingPointData = Cast<UPCGPointData>(StartInputs[0].Data);
+        const UPCGPointData* EndingPointData = Cast<UPCGPointData>(EndInputs[0].Data);
+        if (!StartingPointData || !EndingPointData || StartingPointData->GetPoints().IsEmpty() || EndingPointData->GetPoints().IsEmpty())
+        {
+            PCGE_LOG(Error, GraphAndLog, LOCTEXT("InputNotPointData", "Input is not a point data"));
+            return true;
+        }
+
+        const int32 StartIndex = UPCGPathfindHelper::FindNodeIndex(Graph, StartingPointData->GetPoint(0));
+        const int32 EndIndex = UPCGPathfindHelper::FindNodeIndex(Graph, EndingPointData->GetPoint(0));
+
+        FPathfindSearchState SearchState;
+        const TArray<int32> PathIndices = Hierarchy
+            ? UPCGPathfindHelper::FindPathHierarchical(Graph, *Hierarchy, StartIndex, EndIndex, SearchState)
+            : UPCGPathfindHelper::FindPathIndices(Graph, StartIndex, EndIndex, SearchState);
+
+        UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
+        ChosenPointsData->InitializeFromData(GraphSourceData);
+        PCGPathFindingSettings::WritePathPoints(Graph, PathIndices, ChosenPointsData->GetMutablePoints());
+       
+        // Output all in output collection
+        FPCGTaggedData& ChosenTaggedData = Outputs.Add_GetRef(EndInputs[0]);
+        ChosenTaggedData.Data = ChosenPointsData;
+        ChosenTaggedData.Pin = PCGPathFindingSettings::FinalPointsLabel;
+
+        return true;
+    }
+
+    TArray<FPCGPoint> StartPoints;
+    TArray<FPCGPoint> EndPoints;
+    auto GatherPoints = [Context](const TArray<FPCGTaggedData>& Inputs, TArray<FPCGPoint>& OutPoints)
+    {
+        for (const FPCGTaggedData& Input : Inputs)
+        {
+            if (const UPCGPointData* PointData = Cast<UPCGPointData>(Input.Data))
+            {
+                OutPoints.Append(PointData->GetPoints());
+            }
+            else
+            {
+                PCGE_LOG(Error, GraphAndLog, LOCTEXT("InputNotPointData", "Input is not a point data"));
+            }
+        }
+    };
+    GatherPoints(StartInputs, StartPoints);
+    GatherPoints(EndInputs, EndPoints);
+
+    if (StartPoints.IsEmpty() || EndPoints.IsEmpty())
+    {
+        return true;
+    }
+
+    // A single end point is shared by every start, otherwise points are paired by index
+    const bool bSharedEndPoint = EndPoints.Num() == 1;
+    const int32 NumPairs = bSharedEndPoint ? StartPoints.Num() : FMath::Min(StartPoints.Num(), EndPoints.Num());
+    if (!bSharedEndPoint && StartPoints.Num() != EndPoints.Num())
+    {
+        PCGE_LOG(Warning, GraphAndLog, FText::Format(LOCTEXT("MismatchedPairs", "Start and end point counts differ ({0} vs {1}), only the first {2} pairs are solved"), StartPoints.Num(), EndPoints.Num(), NumPairs));
+    }
+
+    TArray<FIntPoint> NodePairs;
+    NodePairs.SetNumUninitialized(NumPairs);
+    ParallelFor(NumPairs, [&](int32 PairIndex)
+    {
+        const FPCGPoint& EndPoint = EndPoints[bSharedEndPoint ? 0 : PairIndex];
+        NodePairs[PairIndex] = FIntPoint(
+            UPCGPathfindHelper::FindNodeIndex(Graph, StartPoints[PairIndex]),
+            UPCGPathfindHelper::FindNodeIndex(Graph, EndPoint));
+    });
+
+    TArray<TArray<int32>> Paths;
+    UPCGPathfindHelper::FindPathsBatched(Graph, NodePairs, Settings->bUseSharedCostField, Paths, Hierarchy);
+
+    for (int32 PairIndex = 0; PairIndex < NumPairs; ++PairIndex)
+    {
+        UPCGPointData* PathData = NewObject<UPCGPointData>();
+        PathData->InitializeFromData(GraphSourceData);
+
+        PCGPathFindingSettings::WritePathPoints(Graph, Paths[PairIndex], PathData->GetMutablePoints());
+
+        const FPCGPoint& EndPoint = EndPoints[bSharedEndPoint ? 0 : PairIndex];
+
+        FPCGTaggedData& PathTaggedData = Outputs.Emplace_GetRef();
+        PathTaggedData.Data = PathData;
+        PathTaggedData.Pin = PCGPathFindingSettings::FinalPointsLabel;
+        PathTaggedData.Tags.Add(FString::Printf(TEXT("%s:%d"), *PCGPathFindingSettings::StartSeedTag, StartPoints[PairIndex].Seed));
+        PathTaggedData.Tags.Add(FString::Printf(TEXT("%s:%d"), *PCGPathFindingSettings::EndSeedTag, EndPoint.Seed));
+    }
 
     return true;
 }
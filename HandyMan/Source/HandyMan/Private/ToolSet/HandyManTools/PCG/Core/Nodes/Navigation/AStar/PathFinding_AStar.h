@@ -34,6 +34,27 @@ protected:
 	virtual FPCGElementPtr CreateElement() const override;
 	virtual bool UseSeed() const override {return true;}
 	//~End UPCGSettings interface
+
+public:
+	/** Solve every start/end pair instead of only the first one. Start point N is paired with end point N, or every start goes to the end point when only one is provided. Each path is output as its own point data tagged with the pair's seeds. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+	bool bBatchMode = false;
+
+	/** When several pairs share the same end point, flood the graph once from that end point and trace every start back through it instead of running one search per pair. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable, EditCondition = "bBatchMode"))
+	bool bUseSharedCostField = true;
+
+	/** Search a coarse graph of clusters first and only refine the corridor it found. Much faster on large point sets, paths can be slightly longer than the exact shortest path. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Hierarchical", meta = (PCG_Overridable))
+	bool bUseHierarchicalSearch = false;
+
+	/** Width of a cluster in world units. 0 uses 16 times the spacing of the path points. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Hierarchical", meta = (PCG_Overridable, EditCondition = "bUseHierarchicalSearch", ClampMin = "0.0", UIMin = "0.0"))
+	float ClusterSize = 0.0f;
+
+	/** How many crossings are kept between two neighboring clusters. More portals give shorter paths and slower precomputation. */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Hierarchical", meta = (PCG_Overridable, EditCondition = "bUseHierarchicalSearch", ClampMin = "1", UIMin = "1", UIMax = "8"))
+	int32 PortalsPerBoundary = 3;
 	
 };
 
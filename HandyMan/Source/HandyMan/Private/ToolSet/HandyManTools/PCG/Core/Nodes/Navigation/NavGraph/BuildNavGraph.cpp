@@ -0,0 +1,138 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "BuildNavGraph.h"
+#include "PCGComponent.h"
+#include "PCGContext.h"
+#include "Data/PCGPointData.h"
+#include "ToolSet/Algorithms/AStarPathFinding/PCGPathfindHelper.h"
+#include "ToolSet/HandyManTools/PCG/Core/Data/PCGNavGraphData.h"
+
+#define LOCTEXT_NAMESPACE "PCGBuildNavGraphSettings"
+
+namespace PCGBuildNavGraphSettings
+{
+    static const FName NavGraphLabel = TEXT("NavGraph");
+}
+
+UBuildNavGraphSettings::UBuildNavGraphSettings()
+{
+}
+
+FName UBuildNavGraphSettings::AdditionalTaskName() const
+{
+    return NAME_None;
+}
+
+TArray<FPCGPinProperties> UBuildNavGraphSettings::InputPinProperties() const
+{
+    return Super::DefaultPointInputPinProperties();
+}
+
+TArray<FPCGPinProperties> UBuildNavGraphSettings::OutputPinProperties() const
+{
+    TArray<FPCGPinProperties> Properties;
+
+    Properties.Emplace(PCGBuildNavGraphSettings::NavGraphLabel, EPCGDataType::Other);
+
+    return Properties;
+}
+
+FPCGElementPtr UBuildNavGraphSettings::CreateElement() const
+{
+    return MakeShared<FPCGBuildNavGraphElement>();
+}
+
+bool FPCGBuildNavGraphElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGBuildNavGraphElement::Execute);
+
+    check(Context);
+
+    const UBuildNavGraphSettings* Settings = Context->GetInputSettings<UBuildNavGraphSettings>();
+    check(Settings);
+
+    TArray<FPCGTaggedData>& Outputs = Context->OutputData.TaggedData;
+    const UPCGComponent* Component = Context->SourceComponent.Get();
+    const TObjectKey<UPCGComponent> ComponentKey(Component);
+
+    TArray<TPair<int32, TSharedPtr<const FPathfindGraph>>> NewGraphs;
+
+    const TArray<FPCGTaggedData> Inputs = Context->InputData.GetInputsByPin(PCGPinConstants::DefaultInputLabel);
+    for (int32 InputIndex = 0; InputIndex < Inputs.Num(); ++InputIndex)
+    {
+        const FPCGTaggedData& Input = Inputs[InputIndex];
+        const UPCGPointData* PointData = Cast<UPCGPointData>(Input.Data);
+
+        if (!PointData)
+        {
+            PCGE_LOG(Error, GraphAndLog, LOCTEXT("InputNotPointData", "Input is not a point data"));
+            continue;
+        }
+
+        FPathfindGraph Graph;
+
+        // Every input is diffed against the graph built from the same input last time
+        const TSharedPtr<const FPathfindGraph> PreviousGraph = Settings->bIncrementalUpdate && Component
+            ? FindPreviousGraph(FPreviousGraphKey(ComponentKey, InputIndex)) : nullptr;
+        if (PreviousGraph)
+        {
+            UPCGPathfindHelper::UpdateGraph(*PreviousGraph, PointData->GetPoints(), Graph);
+        }
+        else
+        {
+            UPCGPathfindHelper::BuildGraph(PointData->GetPoints(), Graph);
+        }
+
+        if (Settings->bIncrementalUpdate && Component)
+        {
+            NewGraphs.Emplace(InputIndex, MakeShared<const FPathfindGraph>(Graph));
+        }
+
+        UPCGNavGraphData* NavGraphData = NewObject<UPCGNavGraphData>();
+        NavGraphData->Initialize(MoveTemp(Graph), PointData, PointData->GetOrComputeCrc(/*bFullDataCrc=*/true).GetValue());
+
+        // Output all in output collection
+        FPCGTaggedData& NavGraphTaggedData = Outputs.Add_GetRef(Input);
+        NavGraphTaggedData.Data = NavGraphData;
+        NavGraphTaggedData.Pin = PCGBuildNavGraphSettings::NavGraphLabel;
+    }
+
+    StorePreviousGraphs(Component, MoveTemp(NewGraphs));
+
+    return true;
+}
+
+TSharedPtr<const FPathfindGraph> FPCGBuildNavGraphElement::FindPreviousGraph(const FPreviousGraphKey& Key) const
+{
+    FScopeLock Lock(&PreviousGraphsLock);
+    const TSharedPtr<const FPathfindGraph>* PreviousGraph = PreviousGraphs.Find(Key);
+    return PreviousGraph ? *PreviousGraph : nullptr;
+}
+
+void FPCGBuildNavGraphElement::StorePreviousGraphs(const UPCGComponent* Component, TArray<TPair<int32, TSharedPtr<const FPathfindGraph>>>&& Graphs) const
+{
+    const TObjectKey<UPCGComponent> ComponentKey(Component);
+
+    FScopeLock Lock(&PreviousGraphsLock);
+
+    // Replace everything this component stored, and forget components that no longer exist
+    for (auto It = PreviousGraphs.CreateIterator(); It; ++It)
+    {
+        const TObjectKey<UPCGComponent>& Key = It.Key().Key;
+        if (Key == ComponentKey || !Key.ResolveObjectPtr())
+        {
+            It.RemoveCurrent();
+        }
+    }
+
+    if (Component)
+    {
+        for (TPair<int32, TSharedPtr<const FPathfindGraph>>& Graph : Graphs)
+        {
+            PreviousGraphs.Add(FPreviousGraphKey(ComponentKey, Graph.Key), MoveTemp(Graph.Value));
+        }
+    }
+}
+
+#undef LOCTEXT_NAMESPACE
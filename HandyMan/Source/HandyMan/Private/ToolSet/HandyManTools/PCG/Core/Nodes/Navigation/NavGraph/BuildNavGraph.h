@@ -0,0 +1,59 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PCGSettings.h"
+#include "UObject/Object.h"
+#include "ToolSet/Algorithms/AStarPathFinding/PathfindGraph.h"
+#include "BuildNavGraph.generated.h"
+
+class UPCGComponent;
+
+/**
+ * Builds a navigation graph from a point set once, so it can be cached by PCG and shared by every path query.
+ */
+UCLASS(BlueprintType, ClassGroup = (HandyMan))
+class HANDYMAN_API UBuildNavGraphSettings : public UPCGSettings
+{
+	GENERATED_BODY()
+
+public:
+	UBuildNavGraphSettings();
+
+	//~Begin UPCGSettings interface
+#if WITH_EDITOR
+	virtual FName GetDefaultNodeName() const override { return FName(TEXT("BuildNavGraph")); }
+	virtual FText GetDefaultNodeTitle() const override { return NSLOCTEXT("PCGBuildNavGraphSettings", "NodeTitle", "Build Nav Graph"); }
+	virtual FText GetNodeTooltipText() const override { return NSLOCTEXT("PCGBuildNavGraphSettings", "NodeTooltip", "Connect the incoming points into a navigation graph that the A Star Path Finding node can reuse across queries."); }
+	virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Spatial; }
+#endif
+
+	virtual FName AdditionalTaskName() const override;
+
+protected:
+	virtual TArray<FPCGPinProperties> InputPinProperties() const override;
+	virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+	virtual FPCGElementPtr CreateElement() const override;
+	//~End UPCGSettings interface
+
+public:
+	/** Reuse the graph from the previous execution and only relink the area around points that moved */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "Settings", meta = (PCG_Overridable))
+	bool bIncrementalUpdate = true;
+};
+
+class FPCGBuildNavGraphElement : public IPCGElement
+{
+protected:
+	virtual bool ExecuteInternal(FPCGContext* Context) const override;
+
+	// Last graph built for every input of a component, used as the base of incremental updates.
+	// Entries of destroyed components and of inputs that went away are dropped on the next execution.
+	using FPreviousGraphKey = TPair<TObjectKey<UPCGComponent>, int32>;
+	mutable FCriticalSection PreviousGraphsLock;
+	mutable TMap<FPreviousGraphKey, TSharedPtr<const FPathfindGraph>> PreviousGraphs;
+
+	TSharedPtr<const FPathfindGraph> FindPreviousGraph(const FPreviousGraphKey& Key) const;
+	void StorePreviousGraphs(const UPCGComponent* Component, TArray<TPair<int32, TSharedPtr<const FPathfindGraph>>>&& Graphs) const;
+};
@@ -6,6 +6,7 @@
 #include "PCGComponent.h"
 #include "PCGContext.h"
 #include "Data/PCGPointData.h"
+#include "Async/ParallelFor.h"
 
 #define LOCTEXT_NAMESPACE "PCGWorldQuery_SphereTrace"
 namespace PCGSphereTraceSettings
@@ -53,171 +54,185 @@ FPCGElementPtr UPCGWorldQuery_SphereTraceSettings::CreateElement() const
 	return MakeShared<FPCGSphereTraceElement>();
 }
 
+FPCGContext* FPCGSphereTraceElement::Initialize(const FPCGDataCollection& InputData, TWeakObjectPtr<UPCGComponent> SourceComponent, const UPCGNode* Node)
+{
+	FPCGSphereTraceContext* Context = new FPCGSphereTraceContext();
+	Context->InputData = InputData;
+	Context->SourceComponent = SourceComponent;
+	Context->Node = Node;
+
+	return Context;
+}
+
 /// ---------------------------------------------------------
 /// POINT LOOP
-bool FPCGSphereTraceElement::ExecuteInternal(FPCGContext* Context) const
+bool FPCGSphereTraceElement::ExecuteInternal(FPCGContext* InContext) const
 {
-	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGFilterBySeedValueElement::Execute);
+	TRACE_CPUPROFILER_EVENT_SCOPE(FPCGSphereTraceElement::Execute);
 
+	FPCGSphereTraceContext* Context = static_cast<FPCGSphereTraceContext*>(InContext);
 	check(Context);
 
 	const UPCGWorldQuery_SphereTraceSettings* Settings = Context->GetInputSettings<UPCGWorldQuery_SphereTraceSettings>();
 	check(Settings);
 
+	const UWorld* World = Context->SourceComponent.Get()->GetWorld();
+	check(World);
 
-	const TArray<FPCGTaggedData>& OptionalLookAtPoint = Context->InputData.GetInputsByPin(FName("ReferencePoint"));
+	if (!Context->bInitialized)
+	{
+		const TArray<FPCGTaggedData>& OptionalLookAtPoint = Context->InputData.GetInputsByPin(FName("ReferencePoint"));
 
-	bool bShouldOrientPoint = OptionalLookAtPoint.Num() > 0;
+		Context->bShouldOrientPoint = OptionalLookAtPoint.Num() > 0;
+		if (Context->bShouldOrientPoint)
+		{
+			if (const UPCGPointData* OptionalLookAtPointData = Cast<UPCGPointData>(OptionalLookAtPoint[0].Data))
+			{
+				Context->OptionalLookAtLocation = OptionalLookAtPointData->GetPoint(0).Transform.GetRotation().Vector().GetSafeNormal();
+			}
+		}
 
-	FVector OptionalLookAtLocation;
-	if (bShouldOrientPoint)
-	{
-		if (const UPCGPointData* OptionalLookAtPointData = Cast<UPCGPointData>(OptionalLookAtPoint[0].Data))
+		for (const auto& Type : Settings->ChannelsToTrace)
 		{
-			OptionalLookAtLocation = OptionalLookAtPointData->GetPoint(0).Transform.GetRotation().Vector().GetSafeNormal();
+			Context->ObjectQueryParams.AddObjectTypesToQuery(Type);
 		}
+
+		Context->SourceInputs = Context->InputData.GetInputsByPin(FName("Source"));
+		Context->bInitialized = true;
 	}
 	
 	TArray<FPCGTaggedData>& Outputs = Context->OutputData.TaggedData;
-	
-	const UWorld* World = Context->SourceComponent.Get()->GetWorld();
-	check(World);
 
-	for (const FPCGTaggedData& Input : Context->InputData.GetInputsByPin(FName("Source")))
+	while (Context->CurrentInputIndex < Context->SourceInputs.Num())
 	{
+		const FPCGTaggedData& Input = Context->SourceInputs[Context->CurrentInputIndex];
 		const UPCGPointData* PointData = Cast<UPCGPointData>(Input.Data);
 
 		if (!PointData)
 		{
 			PCGE_LOG(Error, GraphAndLog, LOCTEXT("InputNotPointData", "Input is not a point data"));
+			++Context->CurrentInputIndex;
 			continue;
 		}
 
 		const TArray<FPCGPoint>& InPoints = PointData->GetPoints();
+		if (Context->CurrentPointIndex == 0)
+		{
+			Context->PointResults.Reset();
+			Context->PointResults.SetNum(InPoints.Num());
+		}
 
-		// Create output point data. This is the recommended way instead of writing directly to the incoming points.
-		UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
-		ChosenPointsData->InitializeFromData(PointData);
-		TArray<FPCGPoint>& ChosenPoints = ChosenPointsData->GetMutablePoints();
-		FRandomStream RandomStream(Settings->Seed);
-		
-		TArray<FHitResult> OutHits;
-        
-		for (int i =0; i < InPoints.Num(); i++)
+		// Sweep the points in parallel batches and give the frame back once the time budget is spent
+		while (Context->CurrentPointIndex < InPoints.Num())
 		{
-			FVector TraceLocation = InPoints[i].Transform.GetLocation();
-			TraceLocation.Z += Settings->TraceHeightOffset;
-			if (Trace(World, TraceLocation, TraceLocation, Settings->ChannelsToTrace, Settings->SphereRadius, OutHits))
+			const int32 BatchStart = Context->CurrentPointIndex;
+			const int32 BatchEnd = FMath::Min(BatchStart + PointsPerBatch, InPoints.Num());
+
+			ParallelFor(BatchEnd - BatchStart, [this, Context, Settings, World, &InPoints, BatchStart](int32 BatchIndex)
 			{
-				FPCGPoint AlteredPoint = InPoints[i];
-				const FRotator OriginalRot = AlteredPoint.Transform.GetRotation().Rotator();
-				FTransform PointTransform = AlteredPoint.Transform;
+				const int32 i = BatchStart + BatchIndex;
+				TArray<FHitResult> OutHits;
+
+				FVector TraceLocation = InPoints[i].Transform.GetLocation();
+				TraceLocation.Z += Settings->TraceHeightOffset;
+				if (!Trace(World, TraceLocation, TraceLocation, Context->ObjectQueryParams, Settings->SphereRadius, OutHits))
+				{
+					return;
+				}
+
+				const FRotator OriginalRot = InPoints[i].Transform.GetRotation().Rotator();
+
+				// Per point stream so the result doesn't depend on which worker traced the point
+				FRandomStream RandomStream(HashCombine(GetTypeHash(Settings->Seed), GetTypeHash(InPoints[i].Seed)));
+
+				int32 HitIndex = 0;
 				switch (Settings->TransformResolution)
 				{
 				case ETransformResolutionType::First:
-					{
-						if (OutHits[0].Normal.Equals(FVector(0,0,1)))
-						{
-							continue;
-						}
-						
-						FRotator ReorientedNormal = OutHits[0].Normal.Rotation();
-						if (bShouldOrientPoint)
-						{
-							const auto Dot = FVector::DotProduct(OutHits[0].Normal, OptionalLookAtLocation);
-							if (Dot < 0 && FMath::IsNearlyZero(FMath::Abs(Dot)))
-							{
-								ReorientedNormal = (-OutHits[0].Normal).Rotation();
-							}
-						}
-
-						
-						FRotator PointRot = Settings->bInheritSurfaceRotation ? ReorientedNormal : OriginalRot;
-						PointTransform = FTransform(PointRot, OutHits[0].Location);
-					}
+					HitIndex = 0;
 					break;
 				case ETransformResolutionType::Last:
-					{
-						if (OutHits.Last().Normal.Equals(FVector(0,0,1)))
-						{
-							continue;
-						}
-						
-						FRotator ReorientedNormal = OutHits[0].Normal.Rotation();
-						if (bShouldOrientPoint)
-						{
-							const auto Dot = FVector::DotProduct(OutHits[0].Normal, OptionalLookAtLocation);
-							if (Dot < 0 && FMath::IsNearlyZero(FMath::Abs(Dot)))
-							{
-								ReorientedNormal = (-OutHits[0].Normal).Rotation();
-							}
-						}
-
-						
-						FRotator PointRot = Settings->bInheritSurfaceRotation ? ReorientedNormal : OriginalRot;
-						PointTransform = FTransform(PointRot, OutHits.Last().Location);
-					}
+					HitIndex = OutHits.Num() - 1;
 					break;
 				case ETransformResolutionType::Random:
-					{
-						const int32 RandIndex = RandomStream.RandRange(0, OutHits.Num() - 1);
-						if (OutHits[RandIndex].Normal.Equals(FVector(0,0,1)))
-						{
-							continue;
-						}
-						
-						FRotator ReorientedNormal = OutHits[0].Normal.Rotation();
-						if (bShouldOrientPoint)
-						{
-							const auto Dot = FVector::DotProduct(OutHits[0].Normal, OptionalLookAtLocation);
-							if (Dot < 0 && FMath::IsNearlyZero(FMath::Abs(Dot)))
-							{
-								ReorientedNormal = (-OutHits[0].Normal).Rotation();
-							}
-						}
-						
-						FRotator PointRot = Settings->bInheritSurfaceRotation ? ReorientedNormal : OriginalRot;
-						PointTransform = FTransform(PointRot, OutHits[RandIndex].Location);
-					}
+					HitIndex = RandomStream.RandRange(0, OutHits.Num() - 1);
 					break;
 				}
-				
-				AlteredPoint.Transform = PointTransform;
-				ChosenPoints.Add(AlteredPoint);
 
+				if (OutHits[HitIndex].Normal.Equals(FVector(0,0,1)))
+				{
+					return;
+				}
 
-#if ENABLE_DRAW_DEBUG
-				if (Settings->bDebug)
+				FRotator ReorientedNormal = OutHits[0].Normal.Rotation();
+				if (Context->bShouldOrientPoint)
 				{
-					DrawDebugSphere(World, PointTransform.GetLocation(), Settings->SphereRadius, 12, FColor::Red, false, 1.f, 0, 1.25f);
-					DrawDebugBox(World, PointTransform.GetLocation(), FVector(10.f), FColor::Green, false, 1.f, 0, 1.25f);
+					const auto Dot = FVector::DotProduct(OutHits[0].Normal, Context->OptionalLookAtLocation);
+					if (Dot < 0 && FMath::IsNearlyZero(FMath::Abs(Dot)))
+					{
+						ReorientedNormal = (-OutHits[0].Normal).Rotation();
+					}
 				}
-#endif
+
+				FRotator PointRot = Settings->bInheritSurfaceRotation ? ReorientedNormal : OriginalRot;
+				Context->PointResults[i] = FTransform(PointRot, OutHits[HitIndex].Location);
+			});
+
+			Context->CurrentPointIndex = BatchEnd;
+
+			if (Context->CurrentPointIndex < InPoints.Num() && Context->ShouldStop())
+			{
+				return false;
 			}
 		}
-        
+
+		// Create output point data. This is the recommended way instead of writing directly to the incoming points.
+		UPCGPointData* ChosenPointsData = NewObject<UPCGPointData>();
+		ChosenPointsData->InitializeFromData(PointData);
+		TArray<FPCGPoint>& ChosenPoints = ChosenPointsData->GetMutablePoints();
+
+		for (int i =0; i < InPoints.Num(); i++)
+		{
+			if (!Context->PointResults[i].IsSet())
+			{
+				continue;
+			}
+
+			FPCGPoint AlteredPoint = InPoints[i];
+			const FTransform& PointTransform = Context->PointResults[i].GetValue();
+			AlteredPoint.Transform = PointTransform;
+			ChosenPoints.Add(AlteredPoint);
+
+#if ENABLE_DRAW_DEBUG
+			if (Settings->bDebug)
+			{
+				DrawDebugSphere(World, PointTransform.GetLocation(), Settings->SphereRadius, 12, FColor::Red, false, 1.f, 0, 1.25f);
+				DrawDebugBox(World, PointTransform.GetLocation(), FVector(10.f), FColor::Green, false, 1.f, 0, 1.25f);
+			}
+#endif
+		}
         
 		// Output all in output collection
 		FPCGTaggedData& ChosenTaggedData = Outputs.Add_GetRef(Input);
 		ChosenTaggedData.Data = ChosenPointsData;
 		ChosenTaggedData.Pin = PCGSphereTraceSettings::PointsLabel;
 
-		
+		++Context->CurrentInputIndex;
+		Context->CurrentPointIndex = 0;
+
+		if (Context->CurrentInputIndex < Context->SourceInputs.Num() && Context->ShouldStop())
+		{
+			return false;
+		}
 	}
 
 	return true;
 }
 
-bool FPCGSphereTraceElement::Trace(const UWorld* World, const FVector& Start, const FVector& End, const TArray<TEnumAsByte<ECollisionChannel>>& Types, const float& Radius, TArray<FHitResult>& OutHits) const
+bool FPCGSphereTraceElement::Trace(const UWorld* World, const FVector& Start, const FVector& End, const FCollisionObjectQueryParams& Params, const float& Radius, TArray<FHitResult>& OutHits) const
 {
 	if (!World) return false;
 
-	FCollisionObjectQueryParams Params;
-	for (const auto& Type : Types)
-	{
-		Params.AddObjectTypesToQuery(Type);
-	}
-    
 	return World->SweepMultiByObjectType(OutHits, Start, End, FQuat::Identity, Params, FCollisionShape::MakeSphere(Radius));
 }
 
@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "WriteIvyVines.h"
+#include "PCGComponent.h"
+#include "PCGContext.h"
+#include "Data/PCGSplineData.h"
+#include "ToolSet/HandyManTools/PCG/IvyTool/Actor/PCG_IvyActor.h"
+
+#define LOCTEXT_NAMESPACE "PCGWriteIvyVinesSettings"
+
+TArray<FPCGPinProperties> UWriteIvyVinesSettings::InputPinProperties() const
+{
+    TArray<FPCGPinProperties> Properties;
+
+    Properties.Emplace(PCGPinConstants::DefaultInputLabel, EPCGDataType::Spline);
+
+    return Properties;
+}
+
+TArray<FPCGPinProperties> UWriteIvyVinesSettings::OutputPinProperties() const
+{
+    TArray<FPCGPinProperties> Properties;
+
+    Properties.Emplace(PCGPinConstants::DefaultOutputLabel, EPCGDataType::Spline);
+
+    return Properties;
+}
+
+FPCGElementPtr UWriteIvyVinesSettings::CreateElement() const
+{
+    return MakeShared<FPCGWriteIvyVinesElement>();
+}
+
+bool FPCGWriteIvyVinesElement::ExecuteInternal(FPCGContext* Context) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(FPCGWriteIvyVinesElement::Execute);
+
+    check(Context);
+
+    const UPCGComponent* Component = Context->SourceComponent.Get();
+    APCG_IvyActor* IvyActor = Component ? Cast<APCG_IvyActor>(Component->GetOwner()) : nullptr;
+    if (!IvyActor)
+    {
+        PCGE_LOG(Error, GraphAndLog, LOCTEXT("NotAnIvyActor", "The graph is not owned by an ivy actor"));
+        return true;
+    }
+
+    // The splines go through untouched, downstream nodes can still use them
+    FPCGDataCollection Vines;
+    for (const FPCGTaggedData& Input : Context->InputData.GetInputsByPin(PCGPinConstants::DefaultInputLabel))
+    {
+        if (!Cast<UPCGSplineData>(Input.Data))
+        {
+            PCGE_LOG(Warning, GraphAndLog, LOCTEXT("InputNotSplineData", "Input is not a spline data, it is skipped"));
+            continue;
+        }
+
+        Vines.TaggedData.Add(Input);
+        Context->OutputData.TaggedData.Add_GetRef(Input).Pin = PCGPinConstants::DefaultOutputLabel;
+    }
+
+    IvyActor->GenerateVines(Vines);
+
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
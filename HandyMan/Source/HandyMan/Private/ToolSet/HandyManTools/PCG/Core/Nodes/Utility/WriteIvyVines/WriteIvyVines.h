@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PCGSettings.h"
+#include "UObject/Object.h"
+#include "WriteIvyVines.generated.h"
+
+/**
+ * Writes the incoming splines into the vine buffer of the ivy actor that owns the graph, instead of spawning a spline component per vine.
+ */
+UCLASS(BlueprintType, ClassGroup = (HandyMan))
+class HANDYMAN_API UWriteIvyVinesSettings : public UPCGSettings
+{
+	GENERATED_BODY()
+
+public:
+	//~Begin UPCGSettings interface
+#if WITH_EDITOR
+	virtual FName GetDefaultNodeName() const override { return FName(TEXT("WriteIvyVines")); }
+	virtual FText GetDefaultNodeTitle() const override { return NSLOCTEXT("PCGWriteIvyVinesSettings", "NodeTitle", "Write Ivy Vines"); }
+	virtual FText GetNodeTooltipText() const override { return NSLOCTEXT("PCGWriteIvyVinesSettings", "NodeTooltip", "Hand the incoming splines to the owning ivy actor as vines, no spline components are spawned."); }
+	virtual EPCGSettingsType GetType() const override { return EPCGSettingsType::Spawner; }
+#endif
+
+protected:
+	virtual TArray<FPCGPinProperties> InputPinProperties() const override;
+	virtual TArray<FPCGPinProperties> OutputPinProperties() const override;
+	virtual FPCGElementPtr CreateElement() const override;
+	//~End UPCGSettings interface
+};
+
+class FPCGWriteIvyVinesElement : public IPCGElement
+{
+public:
+	// Writes to the actor, so it has to run on the game thread and every execution has to reach it
+	virtual bool CanExecuteOnlyOnMainThread(FPCGContext* Context) const override { return true; }
+	virtual bool IsCacheable(const UPCGSettings* InSettings) const override { return false; }
+
+protected:
+	virtual bool ExecuteInternal(FPCGContext* Context) const override;
+};
@@ -3,6 +3,8 @@
 
 #include "RuntimeIslandGenerator.h"
 
+#include "Async/Async.h"
+#include "Camera/PlayerCameraManager.h"
 #include "GeometryScript/MeshBooleanFunctions.h"
 #include "GeometryScript/MeshDeformFunctions.h"
 #include "GeometryScript/MeshNormalsFunctions.h"
@@ -13,6 +15,11 @@
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Materials/MaterialParameterCollectionInstance.h"
+#include "ToolSet/HandyManTools/PCG/IslandGenerator/Operators/IslandDistanceFieldOp.h"
+
+#if WITH_EDITOR
+#include "LevelEditorViewport.h"
+#endif
 
 
 // Sets default values
@@ -35,106 +42,490 @@ void ARuntimeIslandGenerator::OnConstruction(const FTransform& Transform)
 
 	if (bShouldGenerateOnConstruction)
 	{
-		GenerateIsland();
+		RequestGenerateIsland();
 	}
 }
 
+void ARuntimeIslandGenerator::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	CancelIslandGeneration();
+	ReleaseIslandTiles();
+	
+	Super::EndPlay(EndPlayReason);
+}
+
+void ARuntimeIslandGenerator::BeginDestroy()
+{
+	CancelIslandGeneration();
+	IslandCompute.Reset();
+
+	// Components go away with the actor, only the jobs are left to stop
+	ReleaseIslandTiles(false);
+	
+	Super::BeginDestroy();
+}
+
 void ARuntimeIslandGenerator::SetShouldGenerateOnConstruction(const bool ShouldGenerate)
 {
 	bShouldGenerateOnConstruction = ShouldGenerate;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetRandomSeed(const int32 InRandomSeed)
 {
 	RandomSeed = InRandomSeed;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetIslandChunkCount(const int32 InCount)
 {
 	IslandChunks = InCount;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetIslandBounds(const FVector2D& InBounds)
 {
 	IslandBounds = InBounds;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetMaxSpawnArea(const float SpawnArea)
 {
 	MaxSpawnArea = SpawnArea;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetIslandDepth(const float Depth)
 {
 	IslandDepth = Depth;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetShouldFlattenIsland(const bool ShouldFlatten)
 {
 	bShouldFlattenIsland = ShouldFlatten;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetMaterialParameterCollection(const TObjectPtr<UMaterialParameterCollection>& NewCollection)
 {
 	MaterialParameterCollection = NewCollection;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetGrassColor(const FLinearColor& Color)
 {
 	GrassColor = Color;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetShouldUseHeightMap(const bool ShouldUseHeightMap)
 {
 	bUseHeightMap = ShouldUseHeightMap;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 void ARuntimeIslandGenerator::SetDisplacementOptions(const FGeometryScriptDisplaceFromTextureOptions& Options)
 {
 	DisplaceOptions = Options;
-	GenerateIsland();
+	RequestGenerateIsland();
 
 }
 
+void ARuntimeIslandGenerator::SetShouldUseStreamingTiles(const bool ShouldUseStreamingTiles)
+{
+	bUseStreamingTiles = ShouldUseStreamingTiles;
+	RequestGenerateIsland();
+}
+
 void ARuntimeIslandGenerator::SetHeightMap(UTexture2D* NewHeightMap)
 {
 	HeightMap = NewHeightMap;
-	GenerateIsland();
+	RequestGenerateIsland();
 }
 
 // Called every frame
 void ARuntimeIslandGenerator::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
+
+	if (IslandCompute)
+	{
+		IslandCompute->Tick(DeltaTime);
+	}
+
+	if (bHasPendingGeneration)
+	{
+		GenerateIsland();
+	}
+
+	UpdateIslandTiles(DeltaTime);
 }
 
-void ARuntimeIslandGenerator::GenerateIsland()
+void ARuntimeIslandGenerator::RequestGenerateIsland()
 {
-	GetDynamicMeshComponent()->GetDynamicMesh()->Reset();
-	auto OutputMesh = GetDynamicMeshComponent()->GetDynamicMesh();
+	if (IsStreamingTiles())
+	{
+		GenerateIsland();
+		return;
+	}
+	
+	if (!bUseDistanceField)
+	{
+		if (IslandCompute)
+		{
+			IslandCompute->Cancel();
+		}
+		
+		bHasPendingGeneration = true;
+		return;
+	}
+
+	bHasPendingGeneration = false;
+	
+	if (!IslandCompute)
+	{
+		IslandCompute = MakeUnique<UE::Geometry::TGenericDataBackgroundCompute<UE::Geometry::FDynamicMesh3>>();
+		IslandCompute->Setup(this);
+		IslandCompute->OnResultUpdated.AddUObject(this, &ARuntimeIslandGenerator::OnIslandComputeResult);
+	}
+
+	// Cancels the job in flight, the next one is made from the settings at that point
+	IslandCompute->InvalidateResult();
+}
+
+void ARuntimeIslandGenerator::CancelIslandGeneration()
+{
+	bHasPendingGeneration = false;
+	
+	if (IslandCompute)
+	{
+		IslandCompute->Cancel();
+	}
+
+	for (TPair<FIntPoint, FIslandTile>& TilePair : IslandTiles)
+	{
+		CancelTileJob(TilePair.Value);
+	}
+}
+
+void ARuntimeIslandGenerator::UpdateIslandTiles(float DeltaTime)
+{
+	if (!IsStreamingTiles())
+	{
+		if (!IslandTiles.IsEmpty())
+		{
+			ReleaseIslandTiles();
+		}
+		return;
+	}
+
+	int32 NumPendingJobs = 0;
+	for (TPair<FIntPoint, FIslandTile>& TilePair : IslandTiles)
+	{
+		FIslandTile& Tile = TilePair.Value;
+		if (Tile.PendingLOD == INDEX_NONE)
+		{
+			continue;
+		}
+
+		if (!Tile.PendingMesh.IsReady())
+		{
+			++NumPendingJobs;
+			continue;
+		}
+
+		const int32 LOD = Tile.PendingLOD;
+		TUniquePtr<UE::Geometry::FDynamicMesh3> TileMesh = Tile.PendingMesh.Consume();
+		CancelTileJob(Tile);
+		
+		if (TileMesh)
+		{
+			Tile.LOD = LOD;
+			ApplyTileResult(Tile, MoveTemp(*TileMesh));
+		}
+	}
+
+	TileUpdateTimer -= DeltaTime;
+	if (TileUpdateTimer > 0.0f)
+	{
+		return;
+	}
+	TileUpdateTimer = TileUpdateInterval;
 
+	FVector ViewLocation;
+	if (!GetTileViewLocation(ViewLocation))
+	{
+		return;
+	}
+
+	// The field lives in actor space horizontally
+	const FVector2d Viewer(ViewLocation.X - GetActorLocation().X, ViewLocation.Y - GetActorLocation().Y);
+	const UE::Geometry::FAxisAlignedBox3d FieldBounds = MakeDistanceFieldOp()->GetFieldBounds();
+	if (FieldBounds.IsEmpty())
+	{
+		return;
+	}
+
+	// Only the tiles of the island within the streaming distance are visited
+	const FIntPoint MinTile(
+		FMath::FloorToInt32(FMath::Max(FieldBounds.Min.X, Viewer.X - TileStreamingDistance) / TileSize),
+		FMath::FloorToInt32(FMath::Max(FieldBounds.Min.Y, Viewer.Y - TileStreamingDistance) / TileSize));
+	const FIntPoint MaxTile(
+		FMath::FloorToInt32(FMath::Min(FieldBounds.Max.X, Viewer.X + TileStreamingDistance) / TileSize),
+		FMath::FloorToInt32(FMath::Min(FieldBounds.Max.Y, Viewer.Y + TileStreamingDistance) / TileSize));
+
+	++TileUpdateCount;
+
+	struct FTileRequest
+	{
+		FIntPoint Key;
+		int32 LOD;
+		double Distance;
+	};
+	TArray<FTileRequest> Requests;
+	
+	for (int32 TileY = MinTile.Y; TileY <= MaxTile.Y; ++TileY)
+	{
+		for (int32 TileX = MinTile.X; TileX <= MaxTile.X; ++TileX)
+		{
+			const UE::Geometry::FAxisAlignedBox2d TileBounds(FVector2d(TileX, TileY) * TileSize, FVector2d(TileX + 1, TileY + 1) * TileSize);
+			const double Distance = FMath::Sqrt(TileBounds.DistanceSquared(Viewer));
+			if (Distance > TileStreamingDistance)
+			{
+				continue;
+			}
+
+			const FIntPoint TileKey(TileX, TileY);
+			FIslandTile& Tile = IslandTiles.FindOrAdd(TileKey);
+			Tile.LastSeenUpdate = TileUpdateCount;
+
+			const int32 LOD = GetTileLOD(Distance);
+			if (Tile.LOD != LOD && Tile.PendingLOD != LOD)
+			{
+				Requests.Add({ TileKey, LOD, Distance });
+			}
+		}
+	}
+
+	for (auto TileIt = IslandTiles.CreateIterator(); TileIt; ++TileIt)
+	{
+		FIslandTile& Tile = TileIt.Value();
+		if (Tile.LastSeenUpdate != TileUpdateCount)
+		{
+			CancelTileJob(Tile);
+			if (Tile.Component)
+			{
+				Tile.Component->DestroyComponent();
+			}
+			TileIt.RemoveCurrent();
+		}
+	}
+
+	// Closest first, the rest are picked up by the next updates
+	Requests.Sort([](const FTileRequest& A, const FTileRequest& B) { return A.Distance < B.Distance; });
+	
+	for (const FTileRequest& Request : Requests)
+	{
+		FIslandTile& Tile = IslandTiles.FindChecked(Request.Key);
+		if (Tile.PendingLOD == INDEX_NONE)
+		{
+			if (NumPendingJobs >= MaxTileJobs)
+			{
+				break;
+			}
+			++NumPendingJobs;
+		}
+		
+		LaunchTileJob(Request.Key, Tile, Request.LOD);
+	}
+}
+
+bool ARuntimeIslandGenerator::GetTileViewLocation(FVector& OutLocation) const
+{
+	const UWorld* World = GetWorld();
+	if (!World)
+	{
+		return false;
+	}
+	
+	if (World->IsGameWorld())
+	{
+		if (const APlayerCameraManager* CameraManager = UGameplayStatics::GetPlayerCameraManager(this, 0))
+		{
+			OutLocation = CameraManager->GetCameraLocation();
+			return true;
+		}
+		return false;
+	}
+
+#if WITH_EDITOR
+	if (GCurrentLevelEditingViewportClient)
+	{
+		OutLocation = GCurrentLevelEditingViewportClient->GetViewLocation();
+		return true;
+	}
+#endif
+	
+	return false;
+}
+
+int32 ARuntimeIslandGenerator::GetTileLOD(const double Distance) const
+{
+	return FMath::Clamp(FMath::FloorToInt32(Distance / TileLODDistance), 0, TileLODCount - 1);
+}
+
+void ARuntimeIslandGenerator::LaunchTileJob(const FIntPoint& TileKey, FIslandTile& Tile, const int32 LOD)
+{
+	CancelTileJob(Tile);
+
+	// Every LOD uses cells that divide the tile size, so tiles of the same LOD sample the exact same points along their shared side
+	// and share their border vertices. Where the LOD changes the borders differ by less than a coarsest cell, which the skirts cover
+	TUniquePtr<FIslandDistanceFieldOp> FieldOp = MakeDistanceFieldOp();
+	const int32 BaseCells = PlatformSwitch(TileResolution / 2, TileResolution);
+	FieldOp->CellSize = TileSize / FMath::Max(BaseCells >> LOD, 2);
+	FieldOp->ClipBounds = UE::Geometry::FAxisAlignedBox2d(FVector2d(TileKey.X, TileKey.Y) * TileSize, FVector2d(TileKey.X + 1, TileKey.Y + 1) * TileSize);
+	FieldOp->SkirtDepth = TileSize / FMath::Max(BaseCells >> (TileLODCount - 1), 2);
+
+	TSharedPtr<FThreadSafeBool> CancelFlag = MakeShared<FThreadSafeBool>(false);
+	Tile.PendingLOD = LOD;
+	Tile.PendingCancel = CancelFlag;
+	Tile.PendingMesh = Async(EAsyncExecution::ThreadPool, [FieldOp = MoveTemp(FieldOp), CancelFlag]() mutable -> TUniquePtr<UE::Geometry::FDynamicMesh3>
+	{
+		FProgressCancel Progress;
+		Progress.CancelF = [CancelFlag]() { return static_cast<bool>(*CancelFlag); };
+		
+		FieldOp->CalculateResult(&Progress);
+		if (Progress.Cancelled())
+		{
+			return nullptr;
+		}
+		return FieldOp->ExtractResult();
+	});
+}
+
+void ARuntimeIslandGenerator::CancelTileJob(FIslandTile& Tile) const
+{
+	// The job holds everything it reads, it is left to finish on its own
+	if (Tile.PendingCancel)
+	{
+		*Tile.PendingCancel = true;
+	}
+	
+	Tile.PendingCancel.Reset();
+	Tile.PendingMesh = TFuture<TUniquePtr<UE::Geometry::FDynamicMesh3>>();
+	Tile.PendingLOD = INDEX_NONE;
+}
+
+void ARuntimeIslandGenerator::ApplyTileResult(FIslandTile& Tile, UE::Geometry::FDynamicMesh3&& TileMesh)
+{
+	UDynamicMeshComponent* MainComponent = GetDynamicMeshComponent();
+	if (!MainComponent)
+	{
+		return;
+	}
+	
+	if (!Tile.Component)
+	{
+		// Same space as the main component, the field is generated there
+		Tile.Component = NewObject<UDynamicMeshComponent>(this, NAME_None, RF_Transient);
+		Tile.Component->SetupAttachment(MainComponent);
+		Tile.Component->RegisterComponent();
+	}
+
+	// Picks up material changes made since the tile was created
+	Tile.Component->SetMaterial(0, MainComponent->GetMaterial(0));
+
+	UDynamicMesh* TileMeshObject = Tile.Component->GetDynamicMesh();
+	TileMeshObject->SetMesh(MoveTemp(TileMesh));
+	
+	if (bShouldFlattenIsland)
+	{
+		UGeometryScriptLibrary_MeshUVFunctions::SetMeshUVsFromPlanarProjection
+		(TileMeshObject, 0, FTransform(FRotator::ZeroRotator, FVector::Zero(), FVector(100.f)), FGeometryScriptMeshSelection());
+	}
+
+	// Collision only where the viewer can reach
+	if (Tile.LOD == 0)
+	{
+		// New components have no simple shapes, so the tile mesh itself has to be the collision
+		Tile.Component->SetComplexAsSimpleCollisionEnabled(true, false);
+		Tile.Component->bEnableComplexCollision = true;
+		Tile.Component->SetCollisionProfileName(CollisionProfileName);
+		Tile.Component->UpdateCollision();
+	}
+	else
+	{
+		Tile.Component->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	}
+}
+
+void ARuntimeIslandGenerator::InvalidateIslandTiles()
+{
+	for (TPair<FIntPoint, FIslandTile>& TilePair : IslandTiles)
+	{
+		CancelTileJob(TilePair.Value);
+		TilePair.Value.LOD = INDEX_NONE;
+	}
+	
+	TileUpdateTimer = 0.0f;
+}
+
+void ARuntimeIslandGenerator::ReleaseIslandTiles(const bool bDestroyComponents)
+{
+	for (TPair<FIntPoint, FIslandTile>& TilePair : IslandTiles)
+	{
+		CancelTileJob(TilePair.Value);
+		if (bDestroyComponents && TilePair.Value.Component)
+		{
+			TilePair.Value.Component->DestroyComponent();
+		}
+	}
+	
+	IslandTiles.Empty();
+}
+
+TUniquePtr<UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>> ARuntimeIslandGenerator::MakeNewOperator()
+{
+	return MakeDistanceFieldOp();
+}
+
+void ARuntimeIslandGenerator::OnIslandComputeResult(const TUniquePtr<UE::Geometry::FDynamicMesh3>& Result)
+{
+	if (!Result || !GetDynamicMeshComponent())
+	{
+		return;
+	}
+
+	UDynamicMesh* OutputMesh = GetDynamicMeshComponent()->GetDynamicMesh();
+	OutputMesh->SetMesh(*Result);
+	FinishIsland(OutputMesh);
+}
+
+void ARuntimeIslandGenerator::GetIslandChunks(FIslandFieldChunks& OutChunks) const
+{
 	FRandomStream RandomStream(RandomSeed);
-	TArray<FVector> SpawnLocations;
 
 	for (int i = 0; i < IslandChunks; ++i)
 	{
 		const FVector RandUnitVector = UKismetMathLibrary::RandomUnitVectorFromStream(RandomStream);
-		FVector RandLocation = RandUnitVector * FVector(MaxSpawnArea * 0.5f);
-		RandLocation.Z = GetActorLocation().Z + IslandDepth;
+		const FVector RandLocation = RandUnitVector * FVector(MaxSpawnArea * 0.5f);
 		
-		float Radius = RandomStream.FRandRange(IslandBounds.X, IslandBounds.Y);
+		const float Radius = RandomStream.FRandRange(IslandBounds.X, IslandBounds.Y);
 		
-		SpawnLocations.Add(RandLocation);
+		OutChunks.Add(RandLocation.X, RandLocation.Y, Radius);
+	}
+}
+
+void ARuntimeIslandGenerator::GenerateIslandFromPrimitives(UDynamicMesh* OutputMesh)
+{
+	FIslandFieldChunks Chunks;
+	GetIslandChunks(Chunks);
+
+	for (int i = 0; i < Chunks.Num(); ++i)
+	{
+		const FVector RandLocation(Chunks.CenterX[i], Chunks.CenterY[i], GetActorLocation().Z + IslandDepth);
+		const float Radius = Chunks.BaseRadius[i];
 
 		const FTransform MeshTransform = FTransform(FRotator(0.0f, 0.0f, 0.0f), RandLocation, FVector(1.0f, 1.0f, 1.0f));
 
@@ -185,101 +576,117 @@ void ARuntimeIslandGenerator::GenerateIsland()
 		UGeometryScriptLibrary_MeshUVFunctions::SetMeshUVsFromPlanarProjection
 		(FlattenedMesh, 0, FTransform(FRotator::ZeroRotator, FVector::Zero(), FVector(100.f)), FGeometryScriptMeshSelection());
 	}
+}
 
-	if (HeightMap)
-	{
-		UGeometryScriptLibrary_MeshDeformFunctions::ApplyDisplaceFromTextureMap(OutputMesh, HeightMap,  FGeometryScriptMeshSelection(), DisplaceOptions);
-	}
-
-	ReleaseAllComputeMeshes();
-
-	AddActorWorldOffset(FVector(0,0,0.05));
-	
-	if (MaterialParameterCollection)
-	{
-		if (UMaterialParameterCollectionInstance* MaterialParameterCollectionInstance = GetWorld()->GetParameterCollectionInstance(MaterialParameterCollection))
-		{
-			MaterialParameterCollectionInstance->SetVectorParameterValue(FName("GrassColour"), GrassColor);
-		}	
-	}
-
-	
-	
+TUniquePtr<FIslandDistanceFieldOp> ARuntimeIslandGenerator::MakeDistanceFieldOp() const
+{
+	// Same shapes and heights as the primitive pipeline, the plane cuts become bounds of the field
+	TUniquePtr<FIslandDistanceFieldOp> FieldOp = MakeUnique<FIslandDistanceFieldOp>();
+	GetIslandChunks(FieldOp->Chunks);
+	FieldOp->BaseZ = GetActorLocation().Z + IslandDepth;
+	FieldOp->CutZ = GetActorLocation().Z + IslandDepth * 0.5;
+	FieldOp->FloorHalfExtent = (MaxSpawnArea + 10000.0f) * 0.5;
+	FieldOp->bFlattenTop = bShouldFlattenIsland;
+	FieldOp->TopZ = 0.0;
+	FieldOp->BlendRadius = FieldBlendRadius;
+	FieldOp->Resolution = PlatformSwitch(FieldResolution / 2, FieldResolution);
+	return FieldOp;
 }
 
-int32 ARuntimeIslandGenerator::PlatformSwitch(const int32 LowEnd, const int32 HighEnd) const
+void ARuntimeIslandGenerator::GenerateIslandFromDistanceField(UDynamicMesh* OutputMesh)
 {
-	const FString Platform = UGameplayStatics::GetPlatformName();
+	TRACE_CPUPROFILER_EVENT_SCOPE(ARuntimeIslandGenerator::GenerateIslandFromDistanceField);
 
-	if (Platform.Equals("Android") || Platform.Equals("Switch") || Platform.Equals("IOS"))
-	{
-		return LowEnd;
-	}
+	TUniquePtr<FIslandDistanceFieldOp> FieldOp = MakeDistanceFieldOp();
+	FieldOp->CalculateResult(nullptr);
 
-	return HighEnd;
+	OutputMesh->SetMesh(MoveTemp(*FieldOp->ExtractResult()));
 }
 
-#if WITH_EDITOR
-void ARuntimeIslandGenerator::RegenerateIsland()
+void ARuntimeIslandGenerator::GenerateIsland()
 {
-	GenerateIsland();
-}
+	// Every step below changes the mesh, collision is cooked once for the finished island
+	FPCGCollisionUpdateScope CollisionScope(this);
+	
+	GetDynamicMeshComponent()->GetDynamicMesh()->Reset();
+	auto OutputMesh = GetDynamicMeshComponent()->GetDynamicMesh();
 
-void ARuntimeIslandGenerator::PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent)
-{
-	Super::PostEditChangeProperty(PropertyChangedEvent);
+	// A result still in flight would overwrite this one
+	CancelIslandGeneration();
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, bShouldFlattenIsland))
+	// Tiles replace the single mesh and fill in from the next tick
+	if (IsStreamingTiles())
 	{
-		RerunConstructionScripts();
+		InvalidateIslandTiles();
+		ApplyMaterialParameters();
+		return;
 	}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, MaterialParameterCollection))
+	if (bUseDistanceField)
 	{
-		RerunConstructionScripts();
+		GenerateIslandFromDistanceField(OutputMesh);
 	}
-	
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, IslandBounds))
+	else
 	{
-		RerunConstructionScripts();
+		GenerateIslandFromPrimitives(OutputMesh);
 	}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, IslandChunks))
-	{
-		RerunConstructionScripts();
-	}
+	FinishIsland(OutputMesh);
+}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, MaxSpawnArea))
+void ARuntimeIslandGenerator::FinishIsland(UDynamicMesh* OutputMesh)
+{
+	// The mesh pipeline projects its UVs right after flattening
+	if (bUseDistanceField && bShouldFlattenIsland)
 	{
-		RerunConstructionScripts();
+		UGeometryScriptLibrary_MeshUVFunctions::SetMeshUVsFromPlanarProjection
+		(OutputMesh, 0, FTransform(FRotator::ZeroRotator, FVector::Zero(), FVector(100.f)), FGeometryScriptMeshSelection());
 	}
-
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, IslandDepth))
+	
+	if (HeightMap)
 	{
-		RerunConstructionScripts();
+		UGeometryScriptLibrary_MeshDeformFunctions::ApplyDisplaceFromTextureMap(OutputMesh, HeightMap,  FGeometryScriptMeshSelection(), DisplaceOptions);
 	}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, RandomSeed))
+	ReleaseAllComputeMeshes();
+
+	// Lifts the island off the water plane, only once or every rebuild would move it further up
+	if (!bHasAppliedSurfaceOffset)
 	{
-		RerunConstructionScripts();
+		AddActorWorldOffset(FVector(0,0,0.05));
+		bHasAppliedSurfaceOffset = true;
 	}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, GrassColor))
+	ApplyMaterialParameters();
+}
+
+void ARuntimeIslandGenerator::ApplyMaterialParameters()
+{
+	if (MaterialParameterCollection)
 	{
-		RerunConstructionScripts();
+		if (UMaterialParameterCollectionInstance* MaterialParameterCollectionInstance = GetWorld()->GetParameterCollectionInstance(MaterialParameterCollection))
+		{
+			MaterialParameterCollectionInstance->SetVectorParameterValue(FName("GrassColour"), GrassColor);
+		}	
 	}
+}
 
-	if (PropertyChangedEvent.Property->GetFName() == GET_MEMBER_NAME_CHECKED(ThisClass, bShouldGenerateOnConstruction))
+int32 ARuntimeIslandGenerator::PlatformSwitch(const int32 LowEnd, const int32 HighEnd) const
+{
+	const FString Platform = UGameplayStatics::GetPlatformName();
+
+	if (Platform.Equals("Android") || Platform.Equals("Switch") || Platform.Equals("IOS"))
 	{
-		if (bShouldGenerateOnConstruction)
-		{
-			RerunConstructionScripts();
-		}
+		return LowEnd;
 	}
 
-	
+	return HighEnd;
+}
 
-	
+#if WITH_EDITOR
+void ARuntimeIslandGenerator::RegenerateIsland()
+{
+	GenerateIsland();
 }
 
 #endif
@@ -3,12 +3,37 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Async/Future.h"
+#include "BackgroundModelingComputeSource.h"
+#include "HAL/ThreadSafeBool.h"
+#include "ModelingOperators.h"
 #include "GeometryScript/MeshDeformFunctions.h"
 #include "ToolSet/HandyManTools/PCG/Core/Actors/PCG_DynamicMeshActor_Runtime.h"
 #include "RuntimeIslandGenerator.generated.h"
 
+struct FIslandFieldChunks;
+class FIslandDistanceFieldOp;
+
+/* One streamed piece of the island, generated on its own at the LOD its distance to the viewer asks for */
+struct FIslandTile
+{
+	// Created when the first result arrives, owned by the actor
+	TObjectPtr<UDynamicMeshComponent> Component;
+
+	// LOD of the mesh on the component, INDEX_NONE when it is stale or missing
+	int32 LOD = INDEX_NONE;
+
+	// LOD being generated, INDEX_NONE when no job is in flight
+	int32 PendingLOD = INDEX_NONE;
+	TFuture<TUniquePtr<UE::Geometry::FDynamicMesh3>> PendingMesh;
+	TSharedPtr<FThreadSafeBool> PendingCancel;
+
+	// Last streaming update that found the tile in range
+	uint32 LastSeenUpdate = 0;
+};
+
 UCLASS()
-class HANDYMAN_API ARuntimeIslandGenerator : public APCG_DynamicMeshActor_Runtime
+class HANDYMAN_API ARuntimeIslandGenerator : public APCG_DynamicMeshActor_Runtime, public UE::Geometry::IGenericDataOperatorFactory<UE::Geometry::FDynamicMesh3>
 {
 	GENERATED_BODY()
 
@@ -21,6 +46,8 @@ protected:
 	virtual void BeginPlay() override;
 
 	virtual void OnConstruction(const FTransform& Transform) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+	virtual void BeginDestroy() override;
 	
 	UPROPERTY(EditAnywhere, Category = "Island Generation")
 	bool bShouldGenerateOnConstruction = true;
@@ -58,6 +85,54 @@ protected:
 	UPROPERTY(EditAnywhere, Category = "Island Generation", meta=(EditCondition="bUseHeightMap", EditConditionHides))
 	FGeometryScriptDisplaceFromTextureOptions DisplaceOptions;
 
+	/* Builds the island from a signed distance field of the chunks instead of solidifying, smoothing and cutting primitive meshes.
+	 * Much cheaper, which makes generating at runtime viable
+	 */
+	UPROPERTY(EditAnywhere, Category = "Island Generation")
+	bool bUseDistanceField = false;
+
+	/* Distance over which the chunks blend into each other, replaces the smoothing passes of the mesh pipeline */
+	UPROPERTY(EditAnywhere, Category = "Island Generation", meta=(EditCondition="bUseDistanceField", EditConditionHides, ClampMin = 0))
+	float FieldBlendRadius = 600.0f;
+
+	/* Grid cells along the largest side of the island, halved on mobile platforms */
+	UPROPERTY(EditAnywhere, Category = "Island Generation", meta=(EditCondition="bUseDistanceField", EditConditionHides, ClampMin = 8, ClampMax = 512))
+	int32 FieldResolution = 128;
+
+	/* Splits the distance field island into square tiles that are generated around the viewer and dropped out of range,
+	 * coarser the further they are. Meant for islands too large to keep in memory as a single mesh.
+	 * The height map is not applied to tiles
+	 */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField"))
+	bool bUseStreamingTiles = false;
+
+	/* Side of a tile */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 500))
+	float TileSize = 4000.0f;
+
+	/* Grid cells along the side of a tile at the finest LOD, each further LOD halves them. Halved on mobile platforms */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 4, ClampMax = 256))
+	int32 TileResolution = 32;
+
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 1, ClampMax = 6))
+	int32 TileLODCount = 3;
+
+	/* Distance covered by each LOD, only tiles of the finest one get collision */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 100))
+	float TileLODDistance = 6000.0f;
+
+	/* Tiles further than this from the viewer are unloaded */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 100))
+	float TileStreamingDistance = 20000.0f;
+
+	/* Tiles generating at the same time, the closest ones go first */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 1, ClampMax = 32))
+	int32 MaxTileJobs = 4;
+
+	/* Seconds between two checks of the viewer position */
+	UPROPERTY(EditAnywhere, Category = "Island Generation|Streaming", meta=(EditCondition="bUseDistanceField && bUseStreamingTiles", EditConditionHides, ClampMin = 0))
+	float TileUpdateInterval = 0.2f;
+
 public:
 	void SetShouldGenerateOnConstruction(const bool ShouldGenerate);
 	void SetRandomSeed(const int32 InRandomSeed);
@@ -71,20 +146,87 @@ public:
 	void SetShouldUseHeightMap(const bool ShouldUseHeightMap);
 	void SetHeightMap(UTexture2D* NewHeightMap);
 	void SetDisplacementOptions(const FGeometryScriptDisplaceFromTextureOptions& Options);
+	void SetShouldUseStreamingTiles(const bool ShouldUseStreamingTiles);
 
 	// Called every frame
 	virtual void Tick(float DeltaTime) override;
 
+	// Pending generations are resolved from Tick, which has to run in editor viewports as well
+	virtual bool ShouldTickIfViewportsOnly() const override { return true; }
+
+	/** Generates the island right away, dropping any generation still in flight */
 	UFUNCTION(BlueprintCallable)
 	void GenerateIsland();
 
+	/* Asks for a new island, requests made before the next result are merged into one and the latest settings win.
+	 * The distance field pipeline runs on a background thread and the result is swapped in on the game thread,
+	 * the mesh pipeline runs once on the next tick
+	 */
+	UFUNCTION(BlueprintCallable)
+	void RequestGenerateIsland();
+
+	/** Drops the pending or in flight generation, the current island is kept */
+	UFUNCTION(BlueprintCallable)
+	void CancelIslandGeneration();
+
+	///~ IGenericDataOperatorFactory API
+	virtual TUniquePtr<UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>> MakeNewOperator() override;
+
 	UFUNCTION(BlueprintPure)
 	int32 PlatformSwitch(const int32 LowEnd, const int32 HighEnd) const;
+
+protected:
+	// Chunk placement shared by both pipelines, the same seed gives the same chunks
+	void GetIslandChunks(FIslandFieldChunks& OutChunks) const;
+	
+	void GenerateIslandFromPrimitives(UDynamicMesh* OutputMesh);
+	void GenerateIslandFromDistanceField(UDynamicMesh* OutputMesh);
+
+	// Distance field op for the current settings, only reads plain data once built
+	TUniquePtr<FIslandDistanceFieldOp> MakeDistanceFieldOp() const;
+	
+	// UVs, height map and material parameters, applied to the output of either pipeline
+	void FinishIsland(UDynamicMesh* OutputMesh);
+
+	void OnIslandComputeResult(const TUniquePtr<UE::Geometry::FDynamicMesh3>& Result);
+
+	void ApplyMaterialParameters();
+
+	bool IsStreamingTiles() const { return bUseDistanceField && bUseStreamingTiles; }
+
+	// Loads, unloads and re-LODs tiles around the viewer, and swaps in the tiles that finished generating
+	void UpdateIslandTiles(float DeltaTime);
+
+	// Location tiles are streamed around, the player camera in game and the level viewport in editor
+	bool GetTileViewLocation(FVector& OutLocation) const;
+
+	int32 GetTileLOD(const double Distance) const;
+	void LaunchTileJob(const FIntPoint& TileKey, FIslandTile& Tile, const int32 LOD);
+	void CancelTileJob(FIslandTile& Tile) const;
+	void ApplyTileResult(FIslandTile& Tile, UE::Geometry::FDynamicMesh3&& TileMesh);
+
+	// Regenerates every tile, the meshes on screen stay until their replacement is ready
+	void InvalidateIslandTiles();
+	void ReleaseIslandTiles(const bool bDestroyComponents = true);
+
+	/** Runs the distance field pipeline off the game thread, restarting it cancels the stale job */
+	TUniquePtr<UE::Geometry::TGenericDataBackgroundCompute<UE::Geometry::FDynamicMesh3>> IslandCompute;
+
+	// The mesh pipeline goes through UObjects so requests for it are only coalesced until the next tick
+	bool bHasPendingGeneration = false;
+
+	// Saved with the actor transform the offset is part of
+	UPROPERTY()
+	bool bHasAppliedSurfaceOffset = false;
+
+	TMap<FIntPoint, FIslandTile> IslandTiles;
+	uint32 TileUpdateCount = 0;
+	float TileUpdateTimer = 0.0f;
+
+public:
 	
 #if WITH_EDITOR
 	UFUNCTION(BlueprintCallable, CallInEditor)
 	void RegenerateIsland();
-
-	virtual void PostEditChangeProperty(struct FPropertyChangedEvent& PropertyChangedEvent) override;
 #endif
 };
@@ -0,0 +1,357 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "IslandDistanceFieldOp.h"
+
+#include "Async/ParallelFor.h"
+#include "DynamicMesh/MeshNormals.h"
+#include "Generators/MarchingCubes.h"
+#include "Math/VectorRegister.h"
+
+using namespace UE::Geometry;
+
+namespace IslandDistanceFieldOpLocals
+{
+	static bool IsCancelled(const FProgressCancel* Progress)
+	{
+		return Progress && Progress->Cancelled();
+	}
+
+	/** Distance field sampled on the corners of a regular grid, read back with trilinear interpolation */
+	struct FFieldGrid
+	{
+		FVector3d Origin = FVector3d::Zero();
+		double CellSize = 1.0;
+		FIntVector Dimensions = FIntVector::ZeroValue;
+		TArray<float> Values;
+
+		float Get(const int32 X, const int32 Y, const int32 Z) const
+		{
+			return Values[(Z * Dimensions.Y + Y) * Dimensions.X + X];
+		}
+
+		double Sample(const FVector3d& Position) const
+		{
+			const FVector3d Local = (Position - Origin) / CellSize;
+			const int32 X0 = FMath::Clamp(FMath::FloorToInt32(Local.X), 0, Dimensions.X - 2);
+			const int32 Y0 = FMath::Clamp(FMath::FloorToInt32(Local.Y), 0, Dimensions.Y - 2);
+			const int32 Z0 = FMath::Clamp(FMath::FloorToInt32(Local.Z), 0, Dimensions.Z - 2);
+			const double TX = FMath::Clamp(Local.X - X0, 0.0, 1.0);
+			const double TY = FMath::Clamp(Local.Y - Y0, 0.0, 1.0);
+			const double TZ = FMath::Clamp(Local.Z - Z0, 0.0, 1.0);
+
+			const double V00 = FMath::Lerp<double>(Get(X0, Y0, Z0), Get(X0 + 1, Y0, Z0), TX);
+			const double V10 = FMath::Lerp<double>(Get(X0, Y0 + 1, Z0), Get(X0 + 1, Y0 + 1, Z0), TX);
+			const double V01 = FMath::Lerp<double>(Get(X0, Y0, Z0 + 1), Get(X0 + 1, Y0, Z0 + 1), TX);
+			const double V11 = FMath::Lerp<double>(Get(X0, Y0 + 1, Z0 + 1), Get(X0 + 1, Y0 + 1, Z0 + 1), TX);
+			return FMath::Lerp(FMath::Lerp(V00, V10, TY), FMath::Lerp(V01, V11, TY), TZ);
+		}
+	};
+}
+
+FAxisAlignedBox3d FIslandDistanceFieldOp::GetFieldBounds() const
+{
+	FAxisAlignedBox3d Bounds = FAxisAlignedBox3d::Empty();
+	for (int32 ChunkIndex = 0; ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const double Radius = Chunks.BaseRadius[ChunkIndex] + BlendRadius;
+		Bounds.Contain(FVector3d(Chunks.CenterX[ChunkIndex] - Radius, Chunks.CenterY[ChunkIndex] - Radius, CutZ));
+		Bounds.Contain(FVector3d(Chunks.CenterX[ChunkIndex] + Radius, Chunks.CenterY[ChunkIndex] + Radius, BaseZ + ChunkHeight + BlendRadius));
+	}
+
+	if (Bounds.IsEmpty())
+	{
+		return Bounds;
+	}
+
+	if (bFlattenTop)
+	{
+		Bounds.Max.Z = FMath::Min(Bounds.Max.Z, TopZ);
+	}
+	
+	return Bounds;
+}
+
+void FIslandDistanceFieldOp::EvaluateRow(const double MinX, const double StepX, const int32 NumX, const double Y, const double Z, float* OutValues) const
+{
+	using namespace IslandDistanceFieldOpLocals;
+
+	// The row is evaluated four samples at a time, padded up to a multiple of the lane count
+	const int32 NumPadded = Align(NumX, 4);
+	TArray<double, TInlineAllocator<512>> Row;
+	Row.SetNumUninitialized(NumPadded);
+
+	const VectorRegister4Double Zero = VectorZeroDouble();
+	const VectorRegister4Double One = VectorOneDouble();
+	const VectorRegister4Double LaneOffsets = MakeVectorRegisterDouble(0.0, StepX, 2.0 * StepX, 3.0 * StepX);
+	auto GetLaneX = [&](const int32 Index, const double CenterX)
+	{
+		return VectorAdd(VectorSetFloat1(MinX - CenterX + Index * StepX), LaneOffsets);
+	};
+	
+	// Sea floor slab, centered on the origin from BaseZ up to CutZ
+	{
+		const double SlabHalfHeight = (CutZ - BaseZ) * 0.5;
+		const double DY = FMath::Abs(Y) - FloorHalfExtent;
+		const double DZ = FMath::Abs(Z - (BaseZ + SlabHalfHeight)) - SlabHalfHeight;
+		const VectorRegister4Double OutsideYZSquared = VectorSetFloat1(FMath::Square(FMath::Max(DY, 0.0)) + FMath::Square(FMath::Max(DZ, 0.0)));
+		const VectorRegister4Double MaxYZ = VectorSetFloat1(FMath::Max(DY, DZ));
+		const VectorRegister4Double HalfExtent = VectorSetFloat1(FloorHalfExtent);
+		for (int32 Index = 0; Index < NumPadded; Index += 4)
+		{
+			const VectorRegister4Double DX = VectorSubtract(VectorAbs(GetLaneX(Index, 0.0)), HalfExtent);
+			const VectorRegister4Double OutsideX = VectorMax(DX, Zero);
+			const VectorRegister4Double Inside = VectorMin(VectorMax(DX, MaxYZ), Zero);
+			VectorStore(VectorAdd(VectorSqrt(VectorMultiplyAdd(OutsideX, OutsideX, OutsideYZSquared)), Inside), &Row[Index]);
+		}
+	}
+
+	// Chunks are capped cones around a vertical axis, QY is the height relative to their middle
+	const double HalfHeight = ChunkHeight * 0.5;
+	const double QY = Z - (BaseZ + HalfHeight);
+	const bool bNearChunks = FMath::Abs(QY) <= HalfHeight + BlendRadius;
+	
+	const double CapY = FMath::Abs(QY) - HalfHeight;
+	const VectorRegister4Double BlendK = VectorSetFloat1(BlendRadius);
+	const VectorRegister4Double InvBlendK = VectorSetFloat1(BlendRadius > 0.0 ? 1.0 / BlendRadius : 0.0);
+	const VectorRegister4Double QuarterBlendK = VectorSetFloat1(BlendRadius * 0.25);
+	const VectorRegister4Double CapYSquared = VectorSetFloat1(CapY * CapY);
+	for (int32 ChunkIndex = 0; bNearChunks && ChunkIndex < Chunks.Num(); ++ChunkIndex)
+	{
+		const double DY = Y - Chunks.CenterY[ChunkIndex];
+		const double R1 = Chunks.BaseRadius[ChunkIndex];
+		
+		// The row never gets within blending distance of this chunk
+		if (FMath::Abs(DY) > R1 + BlendRadius) continue;
+		
+		const double R2 = R1 * ChunkTopRadiusScale;
+		const double K2X = R2 - R1;
+		const double K2Y = 2.0 * HalfHeight;
+		const double InvK2LengthSquared = 1.0 / (K2X * K2X + K2Y * K2Y);
+		
+		const VectorRegister4Double DYSquared = VectorSetFloat1(DY * DY);
+		const VectorRegister4Double CapRadius = VectorSetFloat1(QY < 0.0 ? R1 : R2);
+		const VectorRegister4Double VR2 = VectorSetFloat1(R2);
+		const VectorRegister4Double VK2X = VectorSetFloat1(K2X);
+		const VectorRegister4Double VK2Y = VectorSetFloat1(K2Y);
+		const VectorRegister4Double TOffset = VectorSetFloat1((HalfHeight - QY) * K2Y);
+		const VectorRegister4Double VInvK2LengthSquared = VectorSetFloat1(InvK2LengthSquared);
+		const VectorRegister4Double CBYOffset = VectorSetFloat1(QY - HalfHeight);
+		const double CenterX = Chunks.CenterX[ChunkIndex];
+
+		for (int32 Index = 0; Index < NumPadded; Index += 4)
+		{
+			const VectorRegister4Double DX = GetLaneX(Index, CenterX);
+			const VectorRegister4Double QX = VectorSqrt(VectorMultiplyAdd(DX, DX, DYSquared));
+			
+			const VectorRegister4Double CAX = VectorSubtract(QX, VectorMin(QX, CapRadius));
+			const VectorRegister4Double T = VectorMin(VectorMax(VectorMultiply(VectorMultiplyAdd(VectorSubtract(VR2, QX), VK2X, TOffset), VInvK2LengthSquared), Zero), One);
+			const VectorRegister4Double CBX = VectorMultiplyAdd(VK2X, T, VectorSubtract(QX, VR2));
+			const VectorRegister4Double CBY = VectorMultiplyAdd(VK2Y, T, CBYOffset);
+			VectorRegister4Double Distance = VectorSqrt(VectorMin(VectorMultiplyAdd(CAX, CAX, CapYSquared), VectorMultiplyAdd(CBX, CBX, VectorMultiply(CBY, CBY))));
+			if (CapY < 0.0)
+			{
+				Distance = VectorSelect(VectorCompareLT(CBX, Zero), VectorNegate(Distance), Distance);
+			}
+
+			// Polynomial smooth minimum, blends the two distances over BlendRadius
+			const VectorRegister4Double Current = VectorLoad(&Row[Index]);
+			VectorRegister4Double Blended = VectorMin(Current, Distance);
+			if (BlendRadius > 0.0)
+			{
+				const VectorRegister4Double H = VectorMultiply(VectorMax(VectorSubtract(BlendK, VectorAbs(VectorSubtract(Current, Distance))), Zero), InvBlendK);
+				Blended = VectorSubtract(Blended, VectorMultiply(VectorMultiply(H, H), QuarterBlendK));
+			}
+			VectorStore(Blended, &Row[Index]);
+		}
+	}
+
+	// Far from the chunks only the water cut clips the slab
+	const double TopDistance = bNearChunks && bFlattenTop ? Z - TopZ : -UE_BIG_NUMBER;
+	const double Clip = FMath::Max(CutZ - Z, TopDistance);
+	for (int32 Index = 0; Index < NumX; ++Index)
+	{
+		OutValues[Index] = static_cast<float>(FMath::Max(Row[Index], Clip));
+	}
+}
+
+double FIslandDistanceFieldOp::Evaluate(const FVector3d& Position) const
+{
+	float Value = 0.f;
+	EvaluateRow(Position.X, 0.0, 1, Position.Y, Position.Z, &Value);
+	return Value;
+}
+
+void FIslandDistanceFieldOp::CalculateResult(FProgressCancel* Progress)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIslandDistanceFieldOp::CalculateResult);
+	using namespace IslandDistanceFieldOpLocals;
+
+	Result->Clear();
+
+	const FAxisAlignedBox3d FieldBounds = GetFieldBounds();
+	if (FieldBounds.IsEmpty() || FieldBounds.Depth() <= 0.0)
+	{
+		return;
+	}
+
+	FFieldGrid Grid;
+	Grid.CellSize = CellSize > 0.0 ? CellSize : FMath::Max(FieldBounds.Width(), FieldBounds.Height()) / FMath::Max(Resolution, 4);
+
+	// One cell of margin closes the surface at the edges of the island, the clip region is cut exactly
+	FAxisAlignedBox2d Region(FVector2d(FieldBounds.Min.X, FieldBounds.Min.Y) - Grid.CellSize, FVector2d(FieldBounds.Max.X, FieldBounds.Max.Y) + Grid.CellSize);
+	if (!ClipBounds.IsEmpty())
+	{
+		Region = Region.Intersect(ClipBounds);
+		if (Region.IsEmpty() || Region.Area() <= 0.0)
+		{
+			return;
+		}
+	}
+
+	// Corners sit on multiples of the cell size horizontally, and half a cell off the water cut so it lands between two layers and comes out flat.
+	// Sides that are already on the lattice must stay there despite rounding, or neighbouring regions would overlap by a cell
+	const double LatticeTolerance = 1e-6;
+	Grid.Origin = FVector3d(
+		FMath::FloorToDouble(Region.Min.X / Grid.CellSize + LatticeTolerance) * Grid.CellSize,
+		FMath::FloorToDouble(Region.Min.Y / Grid.CellSize + LatticeTolerance) * Grid.CellSize,
+		CutZ - Grid.CellSize * 0.5);
+	Grid.Dimensions.X = FMath::CeilToInt32((Region.Max.X - Grid.Origin.X) / Grid.CellSize - LatticeTolerance) + 1;
+	Grid.Dimensions.Y = FMath::CeilToInt32((Region.Max.Y - Grid.Origin.Y) / Grid.CellSize - LatticeTolerance) + 1;
+	Grid.Dimensions.Z = FMath::CeilToInt32((FieldBounds.Max.Z - Grid.Origin.Z) / Grid.CellSize) + 2;
+	Grid.Values.SetNumUninitialized(Grid.Dimensions.X * Grid.Dimensions.Y * Grid.Dimensions.Z);
+
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(FIslandDistanceFieldOp::SampleField);
+		
+		ParallelFor(Grid.Dimensions.Y * Grid.Dimensions.Z, [this, &Grid, Progress](int32 RowIndex)
+		{
+			if (IsCancelled(Progress)) return;
+			
+			const int32 Y = RowIndex % Grid.Dimensions.Y;
+			const int32 Z = RowIndex / Grid.Dimensions.Y;
+			EvaluateRow(Grid.Origin.X, Grid.CellSize, Grid.Dimensions.X, Grid.Origin.Y + Y * Grid.CellSize, Grid.Origin.Z + Z * Grid.CellSize, &Grid.Values[RowIndex * Grid.Dimensions.X]);
+		});
+	}
+
+	if (IsCancelled(Progress))
+	{
+		return;
+	}
+
+	// Only the grid corners are sampled with a single lerp root, so the lookup never has to evaluate the field again
+	FMarchingCubes MarchingCubes;
+	MarchingCubes.Bounds = FAxisAlignedBox3d(Grid.Origin, Grid.Origin + FVector3d(Grid.Dimensions - FIntVector(1)) * Grid.CellSize);
+	MarchingCubes.CubeSize = Grid.CellSize;
+	MarchingCubes.IsoValue = 0.0;
+	MarchingCubes.RootMode = ERootfindingModes::SingleLerp;
+	MarchingCubes.bParallelCompute = true;
+	MarchingCubes.Implicit = [&Grid](const FVector3d& Position) { return Grid.Sample(Position); };
+	MarchingCubes.CancelF = [Progress]() { return IsCancelled(Progress); };
+	MarchingCubes.Generate();
+
+	if (IsCancelled(Progress))
+	{
+		return;
+	}
+
+	Result->Copy(&MarchingCubes);
+
+	// The water cut closes the field, drop that cap so the bottom stays open.
+	// The cap lies in the layer of cells straddling the cut, but the single lerp root pulls its rim up to half a cell off CutZ,
+	// so anything facing down inside that layer is cap
+	const double CutLayerTop = Grid.Origin.Z + Grid.CellSize;
+	TArray<int32> CapTriangles;
+	for (const int32 TriangleID : Result->TriangleIndicesItr())
+	{
+		FVector3d A, B, C;
+		Result->GetTriVertices(TriangleID, A, B, C);
+		if (FMath::Max3(A.Z, B.Z, C.Z) < CutLayerTop && Result->GetTriNormal(TriangleID).Z < -0.5)
+		{
+			CapTriangles.Add(TriangleID);
+		}
+	}
+	
+	for (const int32 TriangleID : CapTriangles)
+	{
+		Result->RemoveTriangle(TriangleID);
+	}
+	Result->CompactInPlace();
+
+	Result->EnableAttributes();
+	FMeshNormals::InitializeOverlayToPerVertexNormals(Result->Attributes()->PrimaryNormals(), false);
+
+	if (!ClipBounds.IsEmpty() && SkirtDepth > 0.0)
+	{
+		AddClipSkirts(Grid.CellSize * 0.01);
+	}
+}
+
+void FIslandDistanceFieldOp::AddClipSkirts(const double Tolerance)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(FIslandDistanceFieldOp::AddClipSkirts);
+
+	// Both ends on the same side, so the open bottom at the water cut is left alone
+	auto IsOnClipSide = [this, Tolerance](const FVector3d& A, const FVector3d& B)
+	{
+		auto IsOnPlane = [Tolerance](const double ValueA, const double ValueB, const double Plane)
+		{
+			return FMath::Abs(ValueA - Plane) < Tolerance && FMath::Abs(ValueB - Plane) < Tolerance;
+		};
+		return IsOnPlane(A.X, B.X, ClipBounds.Min.X) || IsOnPlane(A.X, B.X, ClipBounds.Max.X)
+			|| IsOnPlane(A.Y, B.Y, ClipBounds.Min.Y) || IsOnPlane(A.Y, B.Y, ClipBounds.Max.Y);
+	};
+
+	TArray<int32> SkirtEdges;
+	for (const int32 EdgeID : Result->BoundaryEdgeIndicesItr())
+	{
+		const FIndex2i EdgeV = Result->GetEdgeV(EdgeID);
+		if (IsOnClipSide(Result->GetVertex(EdgeV.A), Result->GetVertex(EdgeV.B)))
+		{
+			SkirtEdges.Add(EdgeID);
+		}
+	}
+
+	FDynamicMeshNormalOverlay* Normals = Result->Attributes()->PrimaryNormals();
+	TMap<int32, FIndex2i> SkirtVertices;	// edge vertex to its skirt vertex and skirt normal element
+
+	auto GetSkirtVertex = [this, Normals, &SkirtVertices](const int32 VertexID, const int32 TriangleID)
+	{
+		if (const FIndex2i* Existing = SkirtVertices.Find(VertexID))
+		{
+			return *Existing;
+		}
+
+		const FIndex3i TriangleV = Result->GetTriangle(TriangleID);
+		const int32 ParentElement = Normals->GetTriangle(TriangleID)[TriangleV.IndexOf(VertexID)];
+		const FIndex2i Skirt(
+			Result->AppendVertex(Result->GetVertex(VertexID) - FVector3d(0.0, 0.0, SkirtDepth)),
+			Normals->AppendElement(Normals->GetElement(ParentElement)));
+		return SkirtVertices.Add(VertexID, Skirt);
+	};
+
+	for (const int32 EdgeID : SkirtEdges)
+	{
+		// Same winding as the surface, the skirt triangles take the edge in the opposite direction of its triangle
+		const FIndex2i EdgeV = Result->GetOrientedBoundaryEdgeV(EdgeID);
+		const int32 TriangleID = Result->GetEdgeT(EdgeID).A;
+		const FIndex2i SkirtA = GetSkirtVertex(EdgeV.A, TriangleID);
+		const FIndex2i SkirtB = GetSkirtVertex(EdgeV.B, TriangleID);
+
+		const FIndex3i TriangleElements = Normals->GetTriangle(TriangleID);
+		const FIndex3i TriangleV = Result->GetTriangle(TriangleID);
+		const int32 ElementA = TriangleElements[TriangleV.IndexOf(EdgeV.A)];
+		const int32 ElementB = TriangleElements[TriangleV.IndexOf(EdgeV.B)];
+
+		const int32 First = Result->AppendTriangle(EdgeV.B, EdgeV.A, SkirtA.A);
+		if (First >= 0)
+		{
+			Normals->SetTriangle(First, FIndex3i(ElementB, ElementA, SkirtA.B));
+		}
+		const int32 Second = Result->AppendTriangle(EdgeV.B, SkirtA.A, SkirtB.A);
+		if (Second >= 0)
+		{
+			Normals->SetTriangle(Second, FIndex3i(ElementB, SkirtA.B, SkirtB.B));
+		}
+	}
+}
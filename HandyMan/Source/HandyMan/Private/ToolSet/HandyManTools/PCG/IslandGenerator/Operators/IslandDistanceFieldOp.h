@@ -0,0 +1,92 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ModelingOperators.h"
+#include "BoxTypes.h"
+#include "DynamicMesh/DynamicMesh3.h"
+
+/**
+ *  Island chunks stored one array per attribute so a row of the grid can be evaluated against a chunk in a tight loop.
+ *  Every chunk is a truncated cone standing on BaseZ.
+ */
+struct FIslandFieldChunks
+{
+	TArray<double> CenterX;
+	TArray<double> CenterY;
+	TArray<double> BaseRadius;
+
+	void Add(const double X, const double Y, const double Radius)
+	{
+		CenterX.Add(X);
+		CenterY.Add(Y);
+		BaseRadius.Add(Radius);
+	}
+
+	int32 Num() const { return CenterX.Num(); }
+};
+
+/**
+ *  Builds the island surface straight from a signed distance field instead of solidifying and smoothing primitive meshes.
+ *  The field is the smooth union of the chunk cones and the sea floor slab, clipped to the band between the water cut and the top.
+ *  It is sampled on a grid in parallel and the surface is extracted with marching cubes.
+ *  Doesn't touch any UObject so it can run on a background thread.
+ */
+class HANDYMAN_API FIslandDistanceFieldOp : public UE::Geometry::TGenericDataOperator<UE::Geometry::FDynamicMesh3>
+{
+public:
+
+	FIslandFieldChunks Chunks;
+
+	// Height the chunks and the sea floor slab stand on
+	double BaseZ = 0.0;
+
+	double ChunkHeight = 1300.0;
+
+	// Radius at the top of a chunk relative to its base radius
+	double ChunkTopRadiusScale = 0.25;
+
+	// Half size of the sea floor slab on X and Y, it goes from BaseZ up to CutZ
+	double FloorHalfExtent = 0.0;
+
+	// Everything below is cut away and left open like the plane cut of the mesh pipeline
+	double CutZ = 0.0;
+
+	// Flat top of the island when bFlattenTop is set
+	bool bFlattenTop = true;
+	double TopZ = 0.0;
+
+	// Distance over which chunks blend into each other and into the slab
+	double BlendRadius = 600.0;
+
+	// Grid cells along the largest horizontal side of the island
+	int32 Resolution = 128;
+
+	// Size of a grid cell, replaces Resolution when above 0. Cells line up on multiples of it so separate regions meet
+	double CellSize = 0.0;
+
+	// Horizontal region to generate, the whole island when empty. The surface is cut open exactly at its sides, so regions
+	// on the same lattice sample identical points along a shared side and their border vertices match
+	UE::Geometry::FAxisAlignedBox2d ClipBounds = UE::Geometry::FAxisAlignedBox2d::Empty();
+
+	// Depth of the vertical skirts hanging from the edges cut open by ClipBounds. They fill the cracks where regions
+	// with different cell sizes meet
+	double SkirtDepth = 0.0;
+
+	/** Bounds of the surface, from the chunks and the vertical band */
+	UE::Geometry::FAxisAlignedBox3d GetFieldBounds() const;
+
+	/** Signed distance to the island, negative inside */
+	double Evaluate(const FVector3d& Position) const;
+
+	virtual void CalculateResult(FProgressCancel* Progress) override;
+
+protected:
+
+	// Evaluates NumX samples of the row starting at (MinX, Y, Z), StepX apart, four at a time in SIMD lanes
+	void EvaluateRow(const double MinX, const double StepX, const int32 NumX, const double Y, const double Z, float* OutValues) const;
+
+	// Extends the open edges lying on the sides of ClipBounds down by SkirtDepth, reusing the normals of the edges
+	void AddClipSkirts(const double Tolerance);
+};
@@ -4,6 +4,7 @@
 #include "PCG_IvyActor.h"
 #include "PCGComponent.h"
 #include "PCGGraph.h"
+#include "Data/PCGSplineData.h"
 #include "Components/SplineComponent.h"
 #include "GeometryScript/MeshBasicEditFunctions.h"
 #include "Helpers/PCGGraphParametersHelpers.h"
@@ -43,8 +44,67 @@ void APCG_IvyActor::PostInitializeComponents()
 }
 
 
-  void APCG_IvyActor::GenerateVines(const FPCGDataCollection& Data)
+void APCG_IvyActor::GenerateVines(const FPCGDataCollection& Data)
 {
+	TRACE_CPUPROFILER_EVENT_SCOPE(APCG_IvyActor::GenerateVines);
+
+	const FTransform ActorTransform = GetActorTransform();
+	VineBuffer.Reset();
+
+	// Only splines carry the order of their samples, points are skipped
+	for (const FPCGTaggedData& TaggedData : Data.TaggedData)
+	{
+		if (const UPCGSplineData* SplineData = Cast<UPCGSplineData>(TaggedData.Data))
+		{
+			const FPCGSplineStruct& Spline = SplineData->SplineStruct;
+			const double Length = Spline.GetSplineLength();
+			if (Length <= UE_KINDA_SMALL_NUMBER) continue;
+
+			VineBuffer.BeginVine();
+			for (int32 SampleIndex = 0; SampleIndex < VineSampleCount; ++SampleIndex)
+			{
+				const double Distance = Length * SampleIndex / FMath::Max(VineSampleCount - 1, 1);
+				const FTransform SampleTransform = Spline.GetTransformAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World, true);
+				VineBuffer.AddSample(
+					ActorTransform.InverseTransformPosition(SampleTransform.GetLocation()),
+					ActorTransform.InverseTransformVectorNoScale(SampleTransform.GetUnitAxis(EAxis::X)),
+					SampleTransform.GetScale3D().Y);
+			}
+			VineBuffer.EndVine();
+		}
+	}
+	
+	MarkForMeshRebuild(true);
+}
+
+void APCG_IvyActor::ConvertVinesToSplines()
+{
+	if (VineBuffer.IsEmpty()) return;
+
+	Modify();
+	
+	TArray<FTransform> Frames;
+	for (int32 VineIndex = 0; VineIndex < VineBuffer.NumVines(); ++VineIndex)
+	{
+		VineBuffer.GetVineFrames(VineIndex, Frames);
+		
+		USplineComponent* Spline = NewObject<USplineComponent>(this, NAME_None, RF_Transactional);
+		Spline->SetupAttachment(RootComponent);
+		Spline->ClearSplinePoints(false);
+		for (int32 FrameIndex = 0; FrameIndex < Frames.Num(); ++FrameIndex)
+		{
+			FSplinePoint Point(FrameIndex, Frames[FrameIndex].GetLocation(), ESplinePointType::Curve, Frames[FrameIndex].Rotator());
+			Point.Scale = Frames[FrameIndex].GetScale3D();
+			Spline->AddPoint(Point, false);
+		}
+		Spline->UpdateSpline();
+		
+		AddInstanceComponent(Spline);
+		Spline->RegisterComponent();
+	}
+
+	// The splines are the source of the vines now
+	VineBuffer.Reset();
 	MarkForMeshRebuild(true);
 }
 
@@ -73,34 +133,38 @@ void APCG_IvyActor::TransferMeshMaterials(TArray<UMaterialInterface*> Materials)
 void APCG_IvyActor::RebuildGeneratedMesh(UDynamicMesh* TargetMesh)
 {
 	TargetMesh->Reset();
-	UDynamicMesh* CombinedSplinesMesh = nullptr;
-	auto TempMesh = AllocateComputeMesh();
-	
-	TArray<USplineComponent*> Components ;
-	GetComponents(USplineComponent::StaticClass(), Components);
-
 	
 	FSweepOptions SweepOptions;
-	SweepOptions.TargetMesh = TempMesh;
+	SweepOptions.TargetMesh = TargetMesh;
 	SweepOptions.bResetTargetMesh = false;
 	SweepOptions.ShapeType = ESweepShapeType::Circle;
 	SweepOptions.ShapeRadius = VineThickness;
 	SweepOptions.ShapeSegments = 8;
 
-	for (auto Item : Components)
+	if (!VineBuffer.IsEmpty())
 	{
-		SweepOptions.Spline = Item;
-		SweepOptions.SampleSize = Item->GetSplineLength() / 10;
-		CombinedSplinesMesh = UHandyManModelingUtilities::SweepGeometryAlongSpline(SweepOptions, ESplineCoordinateSpace::Local, nullptr);
+		TArray<TArray<FTransform>> SweepPaths;
+		SweepPaths.SetNum(VineBuffer.NumVines());
+		for (int32 VineIndex = 0; VineIndex < VineBuffer.NumVines(); ++VineIndex)
+		{
+			VineBuffer.GetVineFrames(VineIndex, SweepPaths[VineIndex]);
+		}
+		
+		UHandyManModelingUtilities::SweepGeometryAlongPaths(SweepOptions, SweepPaths, ESplineCoordinateSpace::Local, nullptr);
 	}
+	else
+	{
+		TArray<USplineComponent*> Components ;
+		GetComponents(USplineComponent::StaticClass(), Components);
 
-	UGeometryScriptLibrary_MeshBasicEditFunctions::AppendMesh(TargetMesh, CombinedSplinesMesh, FTransform::Identity);
+		// Every vine is sampled the same amount regardless of its length
+		UHandyManModelingUtilities::SweepGeometryAlongSplines(SweepOptions, Components, ESplineCoordinateSpace::Local, VineSampleCount, nullptr);
+	}
+	
 	if (!VineMaterial.ToString().IsEmpty())
 	{
 		DynamicMeshComponent->SetMaterial(0, VineMaterial.LoadSynchronous());
 	}
-	
-	ReleaseAllComputeMeshes();
 }
 
 
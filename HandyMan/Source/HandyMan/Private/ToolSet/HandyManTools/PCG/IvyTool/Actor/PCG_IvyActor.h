@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "PCGData.h"
+#include "ToolSet/HandyManTools/PCG/IvyTool/DataTypes/IvyToolTypes.h"
 #include "ToolSet/HandyManTools/PCG/Core/Actors/PCG_ActorBase.h"
 #include "ToolSet/HandyManTools/PCG/Core/Actors/PCG_DynamicMeshActor_Editor.h"
 #include "PCG_IvyActor.generated.h"
@@ -40,9 +41,14 @@ public:
 	
 	virtual void RebuildGeneratedMesh(UDynamicMesh* TargetMesh) override;
 
+	/** Reads the vines out of the spline data of the graph into the vine buffer and rebuilds the mesh. Called by the Write Ivy Vines node */
 	UFUNCTION(meta=(CallInEditor="true"))
 	void GenerateVines(const FPCGDataCollection& Data);
 
+	/** Creates one spline component per buffered vine. The splines drive the mesh from then on */
+	UFUNCTION(CallInEditor, BlueprintCallable, Category="Handy Man")
+	void ConvertVinesToSplines();
+
 
 protected:
 	// Called when the game starts or when spawned
@@ -82,5 +88,12 @@ private:
 
 	bool bHasGeneratedFromVineUpdate = false;
 
+	/** Vines written by the graph, in actor space. When empty the spline components of the actor are swept instead */
+	UPROPERTY()
+	FIvyVineBuffer VineBuffer;
+
+	/** Samples taken along every vine that comes in as a spline */
+	int32 VineSampleCount = 10;
+
 	float VineThickness = 1.0f;
 };
@@ -0,0 +1,38 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+
+#include "IvyToolTypes.h"
+
+void FIvyVineBuffer::EndVine(const int32 MinSamples)
+{
+	if (VineOffsets.IsEmpty()) return;
+
+	const int32 Start = VineOffsets.Last();
+	if (Positions.Num() - Start >= MinSamples) return;
+
+	Positions.SetNum(Start, EAllowShrinking::No);
+	Tangents.SetNum(Start, EAllowShrinking::No);
+	Radii.SetNum(Start, EAllowShrinking::No);
+	VineOffsets.Pop(EAllowShrinking::No);
+}
+
+void FIvyVineBuffer::GetVineFrames(const int32 VineIndex, TArray<FTransform>& OutFrames) const
+{
+	const int32 Start = GetVineStart(VineIndex);
+	const int32 End = GetVineEnd(VineIndex);
+
+	OutFrames.Reset(End - Start);
+	if (Start >= End) return;
+
+	// Parallel transport, each frame is the previous one turned by the smallest rotation onto the new tangent so the sweep does not twist
+	FVector PreviousTangent = Tangents[Start].GetSafeNormal(UE_SMALL_NUMBER, FVector::ForwardVector);
+	FQuat Rotation = FRotationMatrix::MakeFromX(PreviousTangent).ToQuat();
+	for (int32 SampleIndex = Start; SampleIndex < End; ++SampleIndex)
+	{
+		const FVector Tangent = Tangents[SampleIndex].GetSafeNormal(UE_SMALL_NUMBER, PreviousTangent);
+		Rotation = (FQuat::FindBetweenNormals(PreviousTangent, Tangent) * Rotation).GetNormalized();
+		PreviousTangent = Tangent;
+
+		OutFrames.Emplace(Rotation, Positions[SampleIndex], FVector(1.0, Radii[SampleIndex], Radii[SampleIndex]));
+	}
+}
@@ -0,0 +1,64 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+#include "IvyToolTypes.generated.h"
+
+/**
+ * Every vine of an ivy actor packed one after the other, one array per attribute.
+ * Vine i owns the samples in [VineOffsets[i], VineOffsets[i + 1]), the last vine ends at the sample count.
+ * Radii are relative to the vine thickness of the actor.
+ */
+USTRUCT()
+struct HANDYMAN_API FIvyVineBuffer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FVector> Positions;
+
+	UPROPERTY()
+	TArray<FVector> Tangents;
+
+	UPROPERTY()
+	TArray<float> Radii;
+
+	UPROPERTY()
+	TArray<int32> VineOffsets;
+
+	void Reset()
+	{
+		Positions.Reset();
+		Tangents.Reset();
+		Radii.Reset();
+		VineOffsets.Reset();
+	}
+
+	bool IsEmpty() const { return VineOffsets.IsEmpty(); }
+
+	int32 NumVines() const { return VineOffsets.Num(); }
+
+	int32 NumSamples() const { return Positions.Num(); }
+
+	/** Starts a new vine, following AddSample calls belong to it */
+	void BeginVine() { VineOffsets.Add(Positions.Num()); }
+
+	void AddSample(const FVector& Position, const FVector& Tangent, const float Radius)
+	{
+		Positions.Add(Position);
+		Tangents.Add(Tangent);
+		Radii.Add(Radius);
+	}
+
+	/** Drops the last vine if it ended up with less than MinSamples samples */
+	void EndVine(const int32 MinSamples = 2);
+
+	int32 GetVineStart(const int32 VineIndex) const { return VineOffsets[VineIndex]; }
+
+	int32 GetVineEnd(const int32 VineIndex) const { return VineIndex + 1 < VineOffsets.Num() ? VineOffsets[VineIndex + 1] : Positions.Num(); }
+
+	/** Sweep frames of a vine, X follows the tangent and the YZ scale is the radius */
+	void GetVineFrames(const int32 VineIndex, TArray<FTransform>& OutFrames) const;
+};
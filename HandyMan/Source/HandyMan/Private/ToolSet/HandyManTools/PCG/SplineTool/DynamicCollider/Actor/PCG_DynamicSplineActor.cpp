@@ -3,6 +3,8 @@
 
 #include "PCG_DynamicSplineActor.h"
 
+#include "Async/ParallelFor.h"
+#include "DynamicMesh/MeshNormals.h"
 #include "GeometryScript/MeshModelingFunctions.h"
 #include "GeometryScript/MeshNormalsFunctions.h"
 #include "Metadata/PCGMetadataAttributeTraits.h"
@@ -43,13 +45,28 @@ void APCG_DynamicSplineActor::RefreshDynamicCollision()
 		SweepOptions.bResampleCurve = true;
 		SweepOptions.bFlipOrientation = false;
 		
-
-		UHandyManModelingUtilities::SweepGeometryAlongSpline(SweepOptions, ESplineCoordinateSpace::World);
-
-		FGeometryScriptSplitNormalsOptions SplitNormalsOptions;
-		FGeometryScriptCalculateNormalsOptions CalculateNormalsOptions;
-		CalculateNormalsOptions.bAreaWeighted = true;
-		UGeometryScriptLibrary_MeshNormalsFunctions::ComputeSplitNormals(DynamicMeshComponent->GetDynamicMesh(), SplitNormalsOptions, CalculateNormalsOptions);
+		if (bUseSegmentCollision)
+		{
+			RefreshSegmentCollision(SweepOptions);
+		}
+		else
+		{
+			// The segment cache is transient, the component itself tells whether segment collision was in use
+			InvalidateCollisionSegments();
+			if (DynamicMeshComponent->CollisionType != CTF_UseComplexAsSimple || DynamicMeshComponent->GetSimpleCollisionShapes().GetElementCount() > 0)
+			{
+				DynamicMeshComponent->ClearSimpleCollisionShapes(false);
+				DynamicMeshComponent->CollisionType = CTF_UseComplexAsSimple;
+				DynamicMeshComponent->bEnableComplexCollision = true;
+			}
+			
+			UHandyManModelingUtilities::SweepGeometryAlongSpline(SweepOptions, ESplineCoordinateSpace::World);
+
+			FGeometryScriptSplitNormalsOptions SplitNormalsOptions;
+			FGeometryScriptCalculateNormalsOptions CalculateNormalsOptions;
+			CalculateNormalsOptions.bAreaWeighted = true;
+			UGeometryScriptLibrary_MeshNormalsFunctions::ComputeSplitNormals(DynamicMeshComponent->GetDynamicMesh(), SplitNormalsOptions, CalculateNormalsOptions);
+		}
 
 		if (!SplineMesh.IsNull())
 		{
@@ -59,6 +76,161 @@ void APCG_DynamicSplineActor::RefreshDynamicCollision()
 	}
 }
 
+void APCG_DynamicSplineActor::InvalidateCollisionSegments()
+{
+	CollisionSegments.Empty();
+	CollisionSegmentsShape = FVector2D::ZeroVector;
+}
+
+void APCG_DynamicSplineActor::GetSegmentEndPoints(const int32 SegmentIndex, FDynamicSplineSegment& OutSegment) const
+{
+	const int32 StartIndex = SegmentIndex;
+	const int32 EndIndex = (SegmentIndex + 1) % SplineComponent->GetNumberOfSplinePoints();
+	
+	OutSegment.StartLocation = SplineComponent->GetLocationAtSplinePoint(StartIndex, ESplineCoordinateSpace::World);
+	OutSegment.StartTangent = SplineComponent->GetLeaveTangentAtSplinePoint(StartIndex, ESplineCoordinateSpace::World);
+	OutSegment.StartRotation = SplineComponent->GetQuaternionAtSplinePoint(StartIndex, ESplineCoordinateSpace::World);
+	OutSegment.StartScale = SplineComponent->GetScaleAtSplinePoint(StartIndex);
+	
+	OutSegment.EndLocation = SplineComponent->GetLocationAtSplinePoint(EndIndex, ESplineCoordinateSpace::World);
+	OutSegment.EndTangent = SplineComponent->GetArriveTangentAtSplinePoint(EndIndex, ESplineCoordinateSpace::World);
+	OutSegment.EndRotation = SplineComponent->GetQuaternionAtSplinePoint(EndIndex, ESplineCoordinateSpace::World);
+	OutSegment.EndScale = SplineComponent->GetScaleAtSplinePoint(EndIndex);
+
+	// The interpolation of a segment follows the type of its start point
+	OutSegment.bIsLinear = SplineComponent->GetSplinePointType(StartIndex) == ESplinePointType::Linear;
+}
+
+void APCG_DynamicSplineActor::RefreshSegmentCollision(const FSweepOptions& SweepOptions)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(APCG_DynamicSplineActor::RefreshSegmentCollision);
+
+	if (CollisionSegmentsShape != SweepOptions.ShapeDimensions)
+	{
+		InvalidateCollisionSegments();
+		CollisionSegmentsShape = SweepOptions.ShapeDimensions;
+	}
+
+	const int32 NumSegments = SplineComponent->GetNumberOfSplinePoints() > 1 ? SplineComponent->GetNumberOfSplineSegments() : 0;
+	
+	TArray<FDynamicSplineSegment> Segments;
+	Segments.SetNum(NumSegments);
+	
+	// Reuse the segments whose end points didn't move. Looking one index around covers a point being inserted or removed.
+	// Nothing is taken out of the cache before the sweep succeeded, it stays valid for the next refresh otherwise
+	TArray<int32> DirtySegments;
+	TArray<int32> ReusedFrom;
+	ReusedFrom.Init(INDEX_NONE, NumSegments);
+	TBitArray<> ReusedSegments(false, CollisionSegments.Num());
+	for (int32 SegmentIndex = 0; SegmentIndex < NumSegments; ++SegmentIndex)
+	{
+		FDynamicSplineSegment& Segment = Segments[SegmentIndex];
+		GetSegmentEndPoints(SegmentIndex, Segment);
+
+		bool bFound = false;
+		for (const int32 CachedIndex : {SegmentIndex, SegmentIndex + 1, SegmentIndex - 1})
+		{
+			if (!CollisionSegments.IsValidIndex(CachedIndex) || ReusedSegments[CachedIndex] || !CollisionSegments[CachedIndex].HasSameShape(Segment)) continue;
+			
+			ReusedFrom[SegmentIndex] = CachedIndex;
+			ReusedSegments[CachedIndex] = true;
+			bFound = true;
+			break;
+		}
+
+		if (!bFound)
+		{
+			DirtySegments.Add(SegmentIndex);
+		}
+	}
+
+	auto TakeReusedSegments = [this, &Segments, &ReusedFrom]()
+	{
+		for (int32 SegmentIndex = 0; SegmentIndex < Segments.Num(); ++SegmentIndex)
+		{
+			if (ReusedFrom[SegmentIndex] == INDEX_NONE) continue;
+
+			FDynamicSplineSegment& Cached = CollisionSegments[ReusedFrom[SegmentIndex]];
+			Segments[SegmentIndex].Mesh = MoveTemp(Cached.Mesh);
+			Segments[SegmentIndex].Collision = MoveTemp(Cached.Collision);
+		}
+		CollisionSegments = MoveTemp(Segments);
+	};
+
+	if (DirtySegments.IsEmpty() && Segments.Num() == CollisionSegments.Num())
+	{
+		TakeReusedSegments();
+		return;
+	}
+
+	if (!DirtySegments.IsEmpty())
+	{
+		// Sample on this thread, the sweeps and normals of the dirty segments then run in parallel
+		TArray<TArray<FTransform>> SweepPaths;
+		SweepPaths.SetNum(DirtySegments.Num());
+		for (int32 DirtyIndex = 0; DirtyIndex < DirtySegments.Num(); ++DirtyIndex)
+		{
+			const int32 SegmentIndex = DirtySegments[DirtyIndex];
+			const double StartDistance = SplineComponent->GetDistanceAlongSplineAtSplinePoint(SegmentIndex);
+			const double EndDistance = SegmentIndex + 1 < SplineComponent->GetNumberOfSplinePoints() ? SplineComponent->GetDistanceAlongSplineAtSplinePoint(SegmentIndex + 1) : SplineComponent->GetSplineLength();
+			const int32 NumSamples = Segments[SegmentIndex].bIsLinear ? 2 : CurvedSegmentSampleCount;
+			
+			for (int32 SampleIndex = 0; SampleIndex < NumSamples; ++SampleIndex)
+			{
+				const double Distance = FMath::Lerp(StartDistance, EndDistance, static_cast<double>(SampleIndex) / (NumSamples - 1));
+				SweepPaths[DirtyIndex].Add(SplineComponent->GetTransformAtDistanceAlongSpline(Distance, ESplineCoordinateSpace::World, true));
+			}
+		}
+
+		TArray<UE::Geometry::FDynamicMesh3> SweptMeshes;
+		if (!UHandyManModelingUtilities::GenerateSweepMeshes(SweepOptions, SweepPaths, SweptMeshes, ESplineCoordinateSpace::World))
+		{
+			return;
+		}
+
+		ParallelFor(DirtySegments.Num(), [&DirtySegments, &Segments, &SweptMeshes](int32 DirtyIndex)
+		{
+			FDynamicSplineSegment& Segment = Segments[DirtySegments[DirtyIndex]];
+			Segment.Mesh = MoveTemp(SweptMeshes[DirtyIndex]);
+
+			if (Segment.Mesh.HasAttributes())
+			{
+				UE::Geometry::FMeshNormals::InitializeOverlayTopologyFromOpeningAngle(&Segment.Mesh, Segment.Mesh.Attributes()->PrimaryNormals(), 15.0);
+				UE::Geometry::FMeshNormals::QuickRecomputeOverlayNormals(Segment.Mesh, false, true, true);
+			}
+
+			// The hull of the swept segment, a box for linear segments
+			Segment.Collision.Reset();
+			for (const FVector3d& Vertex : Segment.Mesh.VerticesItr())
+			{
+				Segment.Collision.VertexData.Add(Vertex);
+			}
+			Segment.Collision.UpdateElemBox();
+		});
+	}
+
+	TakeReusedSegments();
+
+	FKAggregateGeom AggGeom;
+	TArray<const UE::Geometry::FDynamicMesh3*> SegmentMeshes;
+	SegmentMeshes.Reserve(CollisionSegments.Num());
+	for (const FDynamicSplineSegment& Segment : CollisionSegments)
+	{
+		if (Segment.Collision.VertexData.Num() >= 4)
+		{
+			AggGeom.ConvexElems.Add(Segment.Collision);
+		}
+		SegmentMeshes.Add(&Segment.Mesh);
+	}
+
+	// Collision is cooked once, by the mesh change notification of the rebuild below
+	DynamicMeshComponent->CollisionType = CTF_UseSimpleAsComplex;
+	DynamicMeshComponent->bEnableComplexCollision = false;
+	DynamicMeshComponent->SetSimpleCollisionShapes(AggGeom, false);
+
+	UHandyManModelingUtilities::AppendMeshes(DynamicMeshComponent->GetDynamicMesh(), SegmentMeshes, true);
+}
+
 void APCG_DynamicSplineActor::OnConstruction(const FTransform& Transform)
 {
 	Super::OnConstruction(Transform);
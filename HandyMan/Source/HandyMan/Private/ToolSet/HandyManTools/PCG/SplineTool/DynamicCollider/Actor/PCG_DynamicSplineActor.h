@@ -6,9 +6,42 @@
 #include "PCGComponent.h"
 #include "ToolSet/HandyManTools/PCG/Core/Actors/PCG_DynamicMeshActor_Runtime.h"
 #include "Components/SplineComponent.h"
+#include "DynamicMesh/DynamicMesh3.h"
+#include "PhysicsEngine/ConvexElem.h"
 #include "ToolSet/HandyManTools/PCG/SplineTool/Interface/SplineToolInterface.h"
 #include "PCG_DynamicSplineActor.generated.h"
 
+struct FSweepOptions;
+
+/** Swept mesh and collision of the span between two spline points, reused until one of its end points changes */
+struct FDynamicSplineSegment
+{
+	FVector StartLocation = FVector::ZeroVector;
+	FVector StartTangent = FVector::ZeroVector;
+	FQuat StartRotation = FQuat::Identity;
+	FVector StartScale = FVector::OneVector;
+	
+	FVector EndLocation = FVector::ZeroVector;
+	FVector EndTangent = FVector::ZeroVector;
+	FQuat EndRotation = FQuat::Identity;
+	FVector EndScale = FVector::OneVector;
+
+	bool bIsLinear = true;
+
+	UE::Geometry::FDynamicMesh3 Mesh;
+	FKConvexElem Collision;
+
+	// Same end points, so the mesh and collision can be reused
+	bool HasSameShape(const FDynamicSplineSegment& Other) const
+	{
+		return bIsLinear == Other.bIsLinear
+			&& StartLocation.Equals(Other.StartLocation) && StartTangent.Equals(Other.StartTangent)
+			&& StartRotation.Equals(Other.StartRotation) && StartScale.Equals(Other.StartScale)
+			&& EndLocation.Equals(Other.EndLocation) && EndTangent.Equals(Other.EndTangent)
+			&& EndRotation.Equals(Other.EndRotation) && EndScale.Equals(Other.EndScale);
+	}
+};
+
 UCLASS()
 class HANDYMAN_API APCG_DynamicSplineActor : public APCG_DynamicMeshActor_Runtime, public ISplineToolInterface
 {
@@ -19,6 +52,9 @@ public:
 	APCG_DynamicSplineActor();
 	void RefreshDynamicCollision();
 
+	/** Drops the cached segments, the next refresh sweeps every segment again */
+	void InvalidateCollisionSegments();
+
 	virtual void OnConstruction(const FTransform& Transform) override;
 
 protected:
@@ -137,6 +173,12 @@ protected:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProceduralSettings)
 	FVector2D ColliderAdditiveScale = FVector2D(1.0f, 1.0f);
 
+	/* Gives every spline segment its own convex collision instead of using the full mesh as complex collision.
+	 * Segments are cached and only the ones next to edited points are swept again
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = ProceduralSettings)
+	bool bUseSegmentCollision = false;
+
 	
 
 	UPROPERTY(BlueprintReadOnly)
@@ -154,5 +196,16 @@ protected:
 	UPROPERTY(VisibleAnywhere, BlueprintReadWrite, Category = "HandyMan")
 	TObjectPtr<class USceneComponent> DefaultSceneComponent;
 
+private:
+
+	void RefreshSegmentCollision(const FSweepOptions& SweepOptions);
+	void GetSegmentEndPoints(const int32 SegmentIndex, FDynamicSplineSegment& OutSegment) const;
+
+	// Segments in spline order, matched by their end points so inserting a point only sweeps its neighbours
+	TArray<FDynamicSplineSegment> CollisionSegments;
+	FVector2D CollisionSegmentsShape = FVector2D::ZeroVector;
+
+	// Samples along a curved segment, linear ones only need their two end points
+	static constexpr int32 CurvedSegmentSampleCount = 8;
 	
 };
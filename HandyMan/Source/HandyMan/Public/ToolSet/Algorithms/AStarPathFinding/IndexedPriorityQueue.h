@@ -0,0 +1,147 @@
+// IndexedPriorityQueue.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Array.h"
+
+/**
+ * Binary min-heap over a fixed range of int32 ids [0, Capacity).
+ * Every id remembers its slot in the heap so its priority can be lowered in place (decrease-key)
+ * instead of pushing duplicates like PriorityQueue<T> does.
+ */
+class IndexedPriorityQueue
+{
+private:
+    // Ids stored in heap order
+    TArray<int32> Heap;
+
+    // Priority of every id, indexed by id
+    TArray<float> Priorities;
+
+    // Slot of every id inside Heap, INDEX_NONE when the id is not queued
+    TArray<int32> HeapSlots;
+
+    bool IsLess(int32 SlotA, int32 SlotB) const
+    {
+        return Priorities[Heap[SlotA]] < Priorities[Heap[SlotB]];
+    }
+
+    void SwapSlots(int32 SlotA, int32 SlotB)
+    {
+        Heap.Swap(SlotA, SlotB);
+        HeapSlots[Heap[SlotA]] = SlotA;
+        HeapSlots[Heap[SlotB]] = SlotB;
+    }
+
+    void BubbleUp(int32 Slot)
+    {
+        while (Slot > 0)
+        {
+            const int32 Parent = (Slot - 1) / 2;
+            if (!IsLess(Slot, Parent))
+            {
+                break;
+            }
+            SwapSlots(Slot, Parent);
+            Slot = Parent;
+        }
+    }
+
+    void BubbleDown(int32 Slot)
+    {
+        const int32 Num = Heap.Num();
+        while (true)
+        {
+            const int32 LeftChild = (2 * Slot) + 1;
+            const int32 RightChild = LeftChild + 1;
+            int32 Smallest = Slot;
+
+            if (LeftChild < Num && IsLess(LeftChild, Smallest))
+            {
+                Smallest = LeftChild;
+            }
+
+            if (RightChild < Num && IsLess(RightChild, Smallest))
+            {
+                Smallest = RightChild;
+            }
+
+            if (Smallest == Slot)
+            {
+                break;
+            }
+            SwapSlots(Slot, Smallest);
+            Slot = Smallest;
+        }
+    }
+
+public:
+    // Clears the queue and sizes it for ids in [0, Capacity). Keeps allocations when the capacity doesn't grow.
+    void Reset(int32 Capacity)
+    {
+        Heap.Reset(Capacity);
+        Priorities.SetNumUninitialized(Capacity, EAllowShrinking::No);
+        HeapSlots.Init(INDEX_NONE, Capacity);
+    }
+
+    // Empties the queue in O(queued ids), keeping the capacity
+    void Clear()
+    {
+        for (const int32 Id : Heap)
+        {
+            HeapSlots[Id] = INDEX_NONE;
+        }
+        Heap.Reset();
+    }
+
+    int32 GetCapacity() const
+    {
+        return HeapSlots.Num();
+    }
+
+    bool IsEmpty() const
+    {
+        return Heap.Num() == 0;
+    }
+
+    bool Contains(int32 Id) const
+    {
+        return HeapSlots[Id] != INDEX_NONE;
+    }
+
+    // Adds Id with the given priority, or moves it up if it is already queued with a higher priority
+    void EnqueueOrDecrease(int32 Id, float Priority)
+    {
+        const int32 Slot = HeapSlots[Id];
+        if (Slot == INDEX_NONE)
+        {
+            Priorities[Id] = Priority;
+            HeapSlots[Id] = Heap.Add(Id);
+            BubbleUp(Heap.Num() - 1);
+        }
+        else if (Priority < Priorities[Id])
+        {
+            Priorities[Id] = Priority;
+            BubbleUp(Slot);
+        }
+    }
+
+    // Removes and returns the id with the lowest priority
+    int32 Dequeue()
+    {
+        check(!IsEmpty());
+
+        const int32 Id = Heap[0];
+        SwapSlots(0, Heap.Num() - 1);
+        Heap.Pop(EAllowShrinking::No);
+        HeapSlots[Id] = INDEX_NONE;
+
+        if (Heap.Num() > 0)
+        {
+            BubbleDown(0);
+        }
+
+        return Id;
+    }
+};
@@ -8,6 +8,7 @@
 #include "PCGSettings.h"
 #include "PCGPoint.h"
 #include "CustomPoint.h"
+#include "PathfindGraph.h"
 
 #include "PCGPathfindHelper.generated.h"
 
@@ -18,7 +19,45 @@ class HANDYMAN_API UPCGPathfindHelper : public UBlueprintFunctionLibrary
 
 public:
     UFUNCTION(BlueprintCallable, Category = "Pathfinding")
-        static TArray<FPCGPoint> FindPath(FPCGPoint StartPoint, FPCGPoint EndPoint, TArray<FPCGPoint> PathPoints);
+        static TArray<FPCGPoint> FindPath(const FPCGPoint& StartPoint, const FPCGPoint& EndPoint, const TArray<FPCGPoint>& PathPoints);
+
+    // Builds the CSR connectivity for PathPoints, connecting every point to the ones within the inferred grid spacing
+    static void BuildGraph(const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph);
+
+    // Same as BuildGraph, but only relinks the nodes around points that moved since PreviousGraph was built.
+    // Falls back to a full build (and returns false) when the point layout changed too much to diff.
+    static bool UpdateGraph(const FPathfindGraph& PreviousGraph, const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph);
+
+    // Runs A* between two node indices of Graph. Returns the node indices from start to end, or an empty array if unreachable.
+    static TArray<int32> FindPathIndices(const FPathfindGraph& Graph, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState);
+
+    // Solves every (start, end) node index pair against Graph in parallel. OutPaths[i] holds the path of NodePairs[i], empty if unreachable.
+    // When bUseSharedCostField is set, pairs heading to the same end node reuse one cost field instead of running separate searches.
+    // When a Hierarchy is given every pair is solved hierarchically instead.
+    static void FindPathsBatched(const FPathfindGraph& Graph, TConstArrayView<FIntPoint> NodePairs, bool bUseSharedCostField, TArray<TArray<int32>>& OutPaths, const FPathfindHierarchy* Hierarchy = nullptr);
+
+    // Clusters Graph into square XY chunks of ClusterSize (0 picks 16 connection distances), keeps up to PortalsPerBoundary
+    // edges between neighboring clusters as portals and precomputes the portal to portal distances inside every cluster.
+    static void BuildHierarchy(const FPathfindGraph& Graph, float ClusterSize, int32 PortalsPerBoundary, FPathfindHierarchy& OutHierarchy);
+
+    // HPA* query: searches the portal graph of Hierarchy, then refines on Graph restricted to the clusters of the coarse path.
+    // Falls back to a flat search when the coarse path can't be refined. The result may be slightly longer than the flat optimum.
+    static TArray<int32> FindPathHierarchical(const FPathfindGraph& Graph, const FPathfindHierarchy& Hierarchy, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState);
+
+    // Floods the whole graph from GoalIndex. Afterwards SearchState.Parents steps every reached node one edge closer to the goal.
+    static void BuildCostField(const FPathfindGraph& Graph, int32 GoalIndex, FPathfindSearchState& SearchState);
+
+    // Follows a cost field built by BuildCostField from StartIndex down to its goal. Empty if StartIndex can't reach the goal.
+    static TArray<int32> ExtractPathFromCostField(const FPathfindSearchState& CostField, int32 StartIndex);
+
+    // Index of the graph node matching Point's seed, or of the nearest node when the point isn't part of the graph
+    static int32 FindNodeIndex(const FPathfindGraph& Graph, const FPCGPoint& Point);
+
+    // Cost returned for edges that are too steep to walk on. Such edges are never traversed.
+    static constexpr float BlockedCost = 999999.0f;
+
+    static float Heuristic(const FVector& Node, const FVector& Goal);
+    static float Cost(const FVector& Node1, const FVector& Node2);
 
 private:
     // Utility function to convert FPCGPoint to FCustomPoint
@@ -27,11 +66,15 @@ private:
     // Utility function to convert FCustomPoint to FPCGPoint
     static FPCGPoint ConvertToPCGPoint(const FCustomPoint& Point);
 
-    static TArray<FCustomPoint> FindShortestPathAStar(const TMap<FCustomPoint, TArray<FCustomPoint>>& Graph, const FCustomPoint& Start, const FCustomPoint& End);
-    static TArray<FGraphNode> BuildGraph(const TArray<FPCGPoint>& PathPoints, float DistanceThreshold);
+    // Fills node positions, seeds and connection distance, leaving the adjacency empty
+    static void InitializeNodes(const TArray<FPCGPoint>& PathPoints, FPathfindGraph& OutGraph);
+
+    // Links the nodes of Graph. When PreviousGraph and DirtyNodes are given, only dirty nodes are relinked.
+    static void BuildAdjacency(FPathfindGraph& Graph, const FPathfindGraph* PreviousGraph, const TBitArray<>* DirtyNodes);
+
+    // Shared A*/Dijkstra loop. With an invalid EndIndex the whole reachable graph is settled.
+    static bool RunSearch(const FPathfindGraph& Graph, int32 StartIndex, int32 EndIndex, FPathfindSearchState& SearchState);
 
-    static float Heuristic(const FGraphNode& Node, const FGraphNode& Goal);
-    static float Cost(const FGraphNode& Node1, const FGraphNode& Node2);
-    static TArray<FGraphNode> GetNeighbors(FGraphNode CurrentNode, TArray<FGraphNode> PathPoints);
-    static void SetupNodeConnections(TArray<FGraphNode>& Nodes, FGraphNode& StartNode, FGraphNode& EndNode);
+    // Median nearest neighbor spacing of the nodes, widened to reach diagonal neighbors, used as the connection radius
+    static float GetConnectionDistance(const TArray<FVector>& Positions);
 };
@@ -0,0 +1,164 @@
+// PathfindGraph.h
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Array.h"
+#include "Containers/ArrayView.h"
+#include "Containers/BitArray.h"
+#include "ToolSet/Algorithms/AStarPathFinding/IndexedPriorityQueue.h"
+
+/**
+ * Navigation graph in compressed sparse row layout.
+ * The neighbors of node i are AdjacencyIndices[AdjacencyOffsets[i] .. AdjacencyOffsets[i + 1]).
+ */
+struct FPathfindGraph
+{
+    TArray<FVector> Positions;
+
+    // Seed of the point every node was created from
+    TArray<int32> Seeds;
+
+    // Radius used to link the nodes
+    float ConnectionDistance = 0.f;
+
+    // Num() + 1 entries, the last one is the total edge count
+    TArray<int32> AdjacencyOffsets;
+
+    TArray<int32> AdjacencyIndices;
+
+    // Traversal cost of every edge, parallel to AdjacencyIndices
+    TArray<float> EdgeCosts;
+
+    int32 Num() const
+    {
+        return Positions.Num();
+    }
+
+    bool IsValidIndex(int32 Index) const
+    {
+        return Positions.IsValidIndex(Index);
+    }
+
+    TConstArrayView<int32> GetNeighbors(int32 Index) const
+    {
+        const int32 Begin = AdjacencyOffsets[Index];
+        return TConstArrayView<int32>(AdjacencyIndices.GetData() + Begin, AdjacencyOffsets[Index + 1] - Begin);
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Positions.GetAllocatedSize() + Seeds.GetAllocatedSize() + AdjacencyOffsets.GetAllocatedSize() + AdjacencyIndices.GetAllocatedSize() + EdgeCosts.GetAllocatedSize();
+    }
+
+    void Reset()
+    {
+        Positions.Reset();
+        Seeds.Reset();
+        ConnectionDistance = 0.f;
+        AdjacencyOffsets.Reset();
+        AdjacencyIndices.Reset();
+        EdgeCosts.Reset();
+    }
+};
+
+/**
+ * Per-query working memory for the A* search. Kept separate from the graph so several searches
+ * can run against the same graph, and so repeated queries don't reallocate.
+ * Only the nodes a search touched are cleared on Reset, so small searches on big graphs stay small.
+ */
+struct FPathfindSearchState
+{
+    TArray<float> CostSoFar;
+    TArray<int32> Parents;
+    TBitArray<> Closed;
+    IndexedPriorityQueue Frontier;
+
+    // Nodes whose cost was set since the last Reset
+    TArray<int32> TouchedNodes;
+
+    void Reset(int32 NumNodes)
+    {
+        if (CostSoFar.Num() != NumNodes || Frontier.GetCapacity() != NumNodes)
+        {
+            CostSoFar.Init(MAX_FLT, NumNodes);
+            Parents.Init(INDEX_NONE, NumNodes);
+            Closed.Init(false, NumNodes);
+            Frontier.Reset(NumNodes);
+        }
+        else
+        {
+            for (const int32 Node : TouchedNodes)
+            {
+                CostSoFar[Node] = MAX_FLT;
+                Parents[Node] = INDEX_NONE;
+                Closed[Node] = false;
+            }
+            Frontier.Clear();
+        }
+        TouchedNodes.Reset();
+    }
+
+    void SetCost(int32 Node, float Cost, int32 Parent)
+    {
+        if (CostSoFar[Node] == MAX_FLT)
+        {
+            TouchedNodes.Add(Node);
+        }
+        CostSoFar[Node] = Cost;
+        Parents[Node] = Parent;
+    }
+};
+
+/**
+ * Two level view of a FPathfindGraph used for hierarchical (HPA*) queries.
+ * Nodes are grouped into square XY clusters, a few boundary edges between neighboring clusters are kept as portals,
+ * and the shortest path between every pair of portals inside a cluster is precomputed. A query searches the small
+ * portal graph first, then refines the path on the full graph restricted to the clusters it went through.
+ */
+struct FPathfindHierarchy
+{
+    float ClusterSize = 0.f;
+
+    int32 NumClusters = 0;
+
+    // Cluster of every graph node
+    TArray<int32> NodeClusters;
+
+    // Graph over the portal nodes. Edges are either the boundary edge between two clusters
+    // or the precomputed shortest path between two portals of the same cluster.
+    FPathfindGraph AbstractGraph;
+
+    // Graph node of every abstract node
+    TArray<int32> PortalNodes;
+
+    // Abstract node of every graph node, INDEX_NONE for nodes that aren't portals
+    TArray<int32> NodePortals;
+
+    // Abstract nodes of every cluster, in the same CSR layout as the graph adjacency
+    TArray<int32> ClusterPortalOffsets;
+    TArray<int32> ClusterPortals;
+
+    bool IsBuiltFor(const FPathfindGraph& Graph) const
+    {
+        return NodeClusters.Num() == Graph.Num() && ClusterPortalOffsets.Num() == NumClusters + 1;
+    }
+
+    TConstArrayView<int32> GetClusterPortals(int32 Cluster) const
+    {
+        const int32 Begin = ClusterPortalOffsets[Cluster];
+        return TConstArrayView<int32>(ClusterPortals.GetData() + Begin, ClusterPortalOffsets[Cluster + 1] - Begin);
+    }
+
+    void Reset()
+    {
+        ClusterSize = 0.f;
+        NumClusters = 0;
+        NodeClusters.Reset();
+        AbstractGraph.Reset();
+        PortalNodes.Reset();
+        NodePortals.Reset();
+        ClusterPortalOffsets.Reset();
+        ClusterPortals.Reset();
+    }
+};
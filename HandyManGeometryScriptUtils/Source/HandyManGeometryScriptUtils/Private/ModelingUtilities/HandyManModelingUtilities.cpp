@@ -7,9 +7,11 @@
 #include "DynamicMeshEditor.h"
 #include "MatrixTypes.h"
 #include "UDynamicMesh.h"
+#include "Async/ParallelFor.h"
 #include "Components/SplineComponent.h"
 #include "CurveOps/TriangulateCurvesOp.h"
 #include "DynamicMesh/MeshTransforms.h"
+#include "Engine/StaticMesh.h"
 #include "Engine/StaticMeshActor.h"
 #include "Generators/SweepGenerator.h"
 #include "GeometryScript/CollisionFunctions.h"
@@ -96,6 +98,243 @@ namespace GodtierMeshPrimitiveFunctions
 }
 #pragma endregion 
 
+#pragma region SweepFunctions
+namespace HandyManSweepFunctions
+{
+	static void BuildCrossSection(const FSweepOptions& SweepOptions, const ESplineCoordinateSpace::Type Space, TArray<FVector2D>& SweepShapeVertices)
+	{
+		switch (SweepOptions.ShapeType)
+		{
+			case ESweepShapeType::Circle:
+				{
+					auto GeometryPath = UGeometryScriptLibrary_PolyPathFunctions::CreateCirclePath3D(FTransform::Identity, SweepOptions.ShapeRadius, SweepOptions.ShapeSegments);
+					for (int i = 0; i < GeometryPath.Path->Num(); i++)
+					{
+						SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
+					}
+					SweepShapeVertices.Emplace(*GeometryPath.Path->GetData());
+					break;
+				}
+			case ESweepShapeType::Triangle:
+				{
+					auto GeometryPath = UGeometryScriptLibrary_PolyPathFunctions::CreateCirclePath3D(FTransform::Identity, SweepOptions.ShapeRadius, 3);
+					for (int i = 0; i < GeometryPath.Path->Num(); i++)
+					{
+						SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
+					}
+					break;
+				}
+			case ESweepShapeType::Box:
+				{
+					SweepShapeVertices.Add(FVector2D(0.0, -SweepOptions.ShapeDimensions.Y));
+					SweepShapeVertices.Add(FVector2D(SweepOptions.ShapeDimensions.X, -SweepOptions.ShapeDimensions.Y));
+					SweepShapeVertices.Add(FVector2D(SweepOptions.ShapeDimensions.X , SweepOptions.ShapeDimensions.Y));
+					SweepShapeVertices.Add(FVector2D(0.f, SweepOptions.ShapeDimensions.Y));
+
+				}
+			case ESweepShapeType::Custom:
+				{
+					FGeometryScriptPolyPath GeometryPath;
+					FGeometryScriptSplineSamplingOptions SamplingOptions;
+					SamplingOptions.CoordinateSpace = Space;
+					SamplingOptions.NumSamples = FMath::Clamp(SweepOptions.ShapeSegments, 4, MAX_int8);
+				    UGeometryScriptLibrary_PolyPathFunctions::ConvertSplineToPolyPath(SweepOptions.CustomProfile, GeometryPath, SamplingOptions);
+				
+					for (int i = 0; i < GeometryPath.Path->Num(); i++)
+					{
+						SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
+					}
+					break;
+				}
+		}
+	}
+
+	// Samples the spline into the frames the cross section is swept along. Touches the spline so it has to run on the game thread
+	static void SampleSweepPath(USplineComponent* Spline, const FSweepOptions& SweepOptions, const ESplineCoordinateSpace::Type Space, const int32 NumSamples, TArray<FTransform>& SweepPath)
+	{
+		TArray<double> SweepFrameTimes;
+
+		bool bShouldResample = false;
+		for (int i = 0; i < Spline->GetNumberOfSplinePoints(); i++)
+		{
+			if (Spline->GetSplinePointType(i) == ESplinePointType::CurveCustomTangent || Spline->GetSplinePointType(i) == ESplinePointType::Curve || SweepOptions.bResampleCurve )
+			{
+				bShouldResample = true;
+				break;
+			}
+		}
+
+		if (bShouldResample)
+		{
+			FGeometryScriptSplineSamplingOptions SampleOptions;
+			SampleOptions.CoordinateSpace = Space;
+			SampleOptions.NumSamples = NumSamples > 0 ? NumSamples : FMath::CeilToInt32(Spline->GetSplineLength() / FMath::Max(SweepOptions.SampleSize, 1));
+			//SampleOptions.ErrorTolerance = 1.0f;
+			UGeometryScriptLibrary_PolyPathFunctions::SampleSplineToTransforms(Spline, SweepPath, SweepFrameTimes, SampleOptions, FTransform::Identity);
+		}
+		else
+		{
+			for (int i = 0; i < Spline->GetNumberOfSplinePoints(); i++)
+			{
+				SweepPath.Add(Spline->GetTransformAtSplinePoint(i, Space));
+			}
+		}
+	}
+
+	// Generates the swept mesh from plain data only, safe to call from any thread
+	static void GenerateSweepMesh(const FSweepOptions& SweepOptions, const TArray<FVector2D>& SweepShapeVertices, const TArray<FTransform>& SweepPath, FDynamicMesh3& OutMesh)
+	{
+		float RotationInDegrees = SweepOptions.RotationAngleDeg;
+		if (SweepOptions.ShapeType == ESweepShapeType::Box)
+		{
+			RotationInDegrees = 90;
+		}
+
+		if (SweepOptions.ShapeType == ESweepShapeType::Triangle)
+		{
+			RotationInDegrees = 30;
+		}
+
+		FMatrix2d Rotation2D = FMatrix2d::RotationDeg(-RotationInDegrees);
+		FGeneralizedCylinderGenerator SweepGen;
+		for (const FVector2D& Point : SweepShapeVertices)
+		{
+			SweepGen.CrossSection.AppendVertex(Rotation2D * FVector2d(Point.X, Point.Y));
+		}
+
+		for (const FTransform& SweepXForm : SweepPath)
+		{
+			SweepGen.Path.Add(SweepXForm.GetLocation());
+			FQuaterniond Rotation(SweepXForm.GetRotation());
+			SweepGen.PathFrames.Add(
+				FFrame3d(SweepXForm.GetLocation(), Rotation.AxisY(), Rotation.AxisZ(), Rotation.AxisX())
+			);
+			FVector3d Scale = SweepXForm.GetScale3D();
+			SweepGen.PathScales.Add(FVector2d(Scale.Y, Scale.Z));
+		}
+
+		SweepGen.bProfileCurveIsClosed = true;
+		SweepGen.bLoop = false;
+		SweepGen.bPolygroupPerQuad = (SweepOptions.PolygroupMode == EGeometryScriptPrimitivePolygroupMode::PerQuad);
+		SweepGen.InitialFrame = FFrame3d(SweepGen.Path[0]);
+		SweepGen.StartScale = SweepOptions.StartEndRadius.X;
+		SweepGen.EndScale = SweepOptions.StartEndRadius.Y;
+		SweepGen.bCapped = SweepOptions.bEndCaps;
+
+		FGeometryScriptPrimitiveOptions PrimitiveOptions;
+		PrimitiveOptions.bFlipOrientation = SweepOptions.bFlipOrientation;
+		PrimitiveOptions.UVMode = SweepOptions.UVMode;
+		PrimitiveOptions.PolygroupMode = SweepOptions.PolygroupMode;
+
+		SweepGen.Generate();
+
+		OutMesh.Copy(&SweepGen);
+		GodtierMeshPrimitiveFunctions::ApplyPrimitiveOptionsToMesh(OutMesh, FTransform::Identity, PrimitiveOptions);
+	}
+
+	template<typename OverlayType>
+	static void AppendOverlay(OverlayType& TargetOverlay, const OverlayType& SourceOverlay, const TArray<int32>& NewTriangleIDs)
+	{
+		TArray<int32> NewElementIDs;
+		NewElementIDs.Init(IndexConstants::InvalidID, SourceOverlay.MaxElementID());
+		for (const int32 ElementID : SourceOverlay.ElementIndicesItr())
+		{
+			NewElementIDs[ElementID] = TargetOverlay.AppendElement(SourceOverlay.GetElement(ElementID));
+		}
+
+		for (int32 TriangleID = 0; TriangleID < NewTriangleIDs.Num(); ++TriangleID)
+		{
+			if (NewTriangleIDs[TriangleID] < 0 || !SourceOverlay.IsSetTriangle(TriangleID)) continue;
+
+			const FIndex3i Elements = SourceOverlay.GetTriangle(TriangleID);
+			TargetOverlay.SetTriangle(NewTriangleIDs[TriangleID], FIndex3i(NewElementIDs[Elements.A], NewElementIDs[Elements.B], NewElementIDs[Elements.C]));
+		}
+	}
+
+	/**
+	 *  Appends compact meshes one after the other. The new vertex and group IDs of every mesh are kept in flat
+	 *  arrays indexed by the source IDs, so unlike FDynamicMeshEditor::AppendMesh no hashed index mapping is built.
+	 *  The target does not have to be compact, AppendVertex may reuse its free IDs.
+	 */
+	static void AppendCompactMeshes(FDynamicMesh3& TargetMesh, TConstArrayView<const FDynamicMesh3*> Meshes)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(HandyManSweepFunctions::AppendCompactMeshes);
+
+		for (const FDynamicMesh3* MeshPtr : Meshes)
+		{
+			if (!MeshPtr || MeshPtr->TriangleCount() == 0) continue;
+
+			const FDynamicMesh3& Mesh = *MeshPtr;
+
+			TargetMesh.EnableMatchingAttributes(Mesh, false);
+
+			if (!Mesh.IsCompact())
+			{
+				FMeshIndexMappings Mappings;
+				FDynamicMeshEditor Editor(&TargetMesh);
+				Editor.AppendMesh(&Mesh, Mappings);
+				continue;
+			}
+
+			TArray<int32> NewVertexIDs;
+			NewVertexIDs.SetNumUninitialized(Mesh.MaxVertexID());
+			for (int32 VertexID = 0; VertexID < Mesh.MaxVertexID(); ++VertexID)
+			{
+				NewVertexIDs[VertexID] = TargetMesh.AppendVertex(Mesh, VertexID);
+			}
+
+			TArray<int32> NewGroupIDs;
+			NewGroupIDs.Init(IndexConstants::InvalidID, Mesh.MaxGroupID());
+			auto MapGroup = [&TargetMesh, &NewGroupIDs](const int32 GroupID)
+			{
+				if (!NewGroupIDs.IsValidIndex(GroupID)) return 0;
+				if (NewGroupIDs[GroupID] == IndexConstants::InvalidID)
+				{
+					NewGroupIDs[GroupID] = TargetMesh.AllocateTriangleGroup();
+				}
+				return NewGroupIDs[GroupID];
+			};
+
+			TArray<int32> NewTriangleIDs;
+			NewTriangleIDs.SetNumUninitialized(Mesh.MaxTriangleID());
+			for (int32 TriangleID = 0; TriangleID < Mesh.MaxTriangleID(); ++TriangleID)
+			{
+				const FIndex3i Triangle = Mesh.GetTriangle(TriangleID);
+				NewTriangleIDs[TriangleID] = TargetMesh.AppendTriangle(
+					FIndex3i(NewVertexIDs[Triangle.A], NewVertexIDs[Triangle.B], NewVertexIDs[Triangle.C]),
+					MapGroup(Mesh.GetTriangleGroup(TriangleID)));
+			}
+
+			if (!TargetMesh.HasAttributes() || !Mesh.HasAttributes()) continue;
+
+			FDynamicMeshAttributeSet* TargetAttributes = TargetMesh.Attributes();
+			const FDynamicMeshAttributeSet* SourceAttributes = Mesh.Attributes();
+
+			const int32 NumUVLayers = FMath::Min(TargetAttributes->NumUVLayers(), SourceAttributes->NumUVLayers());
+			for (int32 Layer = 0; Layer < NumUVLayers; ++Layer)
+			{
+				AppendOverlay(*TargetAttributes->GetUVLayer(Layer), *SourceAttributes->GetUVLayer(Layer), NewTriangleIDs);
+			}
+
+			const int32 NumNormalLayers = FMath::Min(TargetAttributes->NumNormalLayers(), SourceAttributes->NumNormalLayers());
+			for (int32 Layer = 0; Layer < NumNormalLayers; ++Layer)
+			{
+				AppendOverlay(*TargetAttributes->GetNormalLayer(Layer), *SourceAttributes->GetNormalLayer(Layer), NewTriangleIDs);
+			}
+
+			if (TargetAttributes->HasMaterialID() && SourceAttributes->HasMaterialID())
+			{
+				for (int32 TriangleID = 0; TriangleID < NewTriangleIDs.Num(); ++TriangleID)
+				{
+					if (NewTriangleIDs[TriangleID] < 0) continue;
+					TargetAttributes->GetMaterialID()->SetValue(NewTriangleIDs[TriangleID], SourceAttributes->GetMaterialID()->GetValue(TriangleID));
+				}
+			}
+		}
+	}
+}
+#pragma endregion
+
 #define LOCTEXT_NAMESPACE "HandyManModelingUtilities"
 
 UHandyManModelingUtilities::UHandyManModelingUtilities(const FObjectInitializer& ObjectInitializer)
@@ -110,7 +349,6 @@ UDynamicMesh* UHandyManModelingUtilities::SweepGeometryAlongSpline(FSweepOptions
 	
 	TArray<FVector2D> SweepShapeVertices;
 	TArray<FTransform> SweepPath;
-	TArray<double> SweepFrameTimes;
 
 	
 	
@@ -131,50 +369,7 @@ UDynamicMesh* UHandyManModelingUtilities::SweepGeometryAlongSpline(FSweepOptions
 		return TargetMesh;
 	}
 	
-	switch (SweepOptions.ShapeType)
-	{
-		case ESweepShapeType::Circle:
-			{
-				auto GeometryPath = UGeometryScriptLibrary_PolyPathFunctions::CreateCirclePath3D(FTransform::Identity, SweepOptions.ShapeRadius, SweepOptions.ShapeSegments);
-				for (int i = 0; i < GeometryPath.Path->Num(); i++)
-				{
-					SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
-				}
-				SweepShapeVertices.Emplace(*GeometryPath.Path->GetData());
-				break;
-			}
-		case ESweepShapeType::Triangle:
-			{
-				auto GeometryPath = UGeometryScriptLibrary_PolyPathFunctions::CreateCirclePath3D(FTransform::Identity, SweepOptions.ShapeRadius, 3);
-				for (int i = 0; i < GeometryPath.Path->Num(); i++)
-				{
-					SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
-				}
-				break;
-			}
-		case ESweepShapeType::Box:
-			{
-				SweepShapeVertices.Add(FVector2D(0.0, -SweepOptions.ShapeDimensions.Y));
-				SweepShapeVertices.Add(FVector2D(SweepOptions.ShapeDimensions.X, -SweepOptions.ShapeDimensions.Y));
-				SweepShapeVertices.Add(FVector2D(SweepOptions.ShapeDimensions.X , SweepOptions.ShapeDimensions.Y));
-				SweepShapeVertices.Add(FVector2D(0.f, SweepOptions.ShapeDimensions.Y));
-
-			}
-		case ESweepShapeType::Custom:
-			{
-				FGeometryScriptPolyPath GeometryPath;
-				FGeometryScriptSplineSamplingOptions SamplingOptions;
-				SamplingOptions.CoordinateSpace = Space;
-				SamplingOptions.NumSamples = FMath::Clamp(SweepOptions.ShapeSegments, 4, MAX_int8);
-			    UGeometryScriptLibrary_PolyPathFunctions::ConvertSplineToPolyPath(SweepOptions.CustomProfile, GeometryPath, SamplingOptions);
-				
-				for (int i = 0; i < GeometryPath.Path->Num(); i++)
-				{
-					SweepShapeVertices.Add(FVector2D(GeometryPath.Path->GetData()[i].X, GeometryPath.Path->GetData()[i].Y));
-				}
-				break;
-			}
-	}
+	HandyManSweepFunctions::BuildCrossSection(SweepOptions, Space, SweepShapeVertices);
 	
 	if (SweepShapeVertices.Num() < 2)
 	{
@@ -182,110 +377,143 @@ UDynamicMesh* UHandyManModelingUtilities::SweepGeometryAlongSpline(FSweepOptions
 		return TargetMesh;
 	}
 
-	bool bShouldResample = false;
-	for (int i = 0; i < Spline->GetNumberOfSplinePoints(); i++)
+	HandyManSweepFunctions::SampleSweepPath(Spline, SweepOptions, Space, 0, SweepPath);
+	
+	if (SweepPath.Num() < 2)
 	{
-		if (Spline->GetSplinePointType(i) == ESplinePointType::CurveCustomTangent || Spline->GetSplinePointType(i) == ESplinePointType::Curve || SweepOptions.bResampleCurve )
-		{
-			bShouldResample = true;
-			break;
-		}
+		UE::Geometry::AppendError(Debug, EGeometryScriptErrorType::InvalidInputs, LOCTEXT("AppendSweepPolyline_InvalidSweepPath", "AppendSweepPolyline: SweepPath array requires at least 2 positions"));
+		return TargetMesh;
 	}
 
-	if (bShouldResample)
-	{
-		FGeometryScriptSplineSamplingOptions SampleOptions;
-		SampleOptions.CoordinateSpace = Space;
-		SampleOptions.NumSamples = FMath::CeilToInt32(Spline->GetSplineLength() / SweepOptions.SampleSize);
-		//SampleOptions.ErrorTolerance = 1.0f;
-		UGeometryScriptLibrary_PolyPathFunctions::SampleSplineToTransforms(Spline, SweepPath, SweepFrameTimes, SampleOptions, FTransform::Identity);
-		
-		/*TArray<FVector> Vertices;
-		Spline->ConvertSplineToPolyLine(ESplineCoordinateSpace::World, 1, Vertices);
+	FDynamicMesh3 SweptMesh;
+	HandyManSweepFunctions::GenerateSweepMesh(SweepOptions, SweepShapeVertices, SweepPath, SweptMesh);
 
-		for (const auto& Point : Vertices)
-		{
-			SweepPath.Add(FTransform(Point));
-		}*/
-
-	}
-	else
+	TargetMesh->EditMesh([&](FDynamicMesh3& EditMesh)
 	{
-		for (int i = 0; i < Spline->GetNumberOfSplinePoints(); i++)
+		if (EditMesh.TriangleCount() == 0)
 		{
-			SweepPath.Add(Spline->GetTransformAtSplinePoint(i, Space));
+			EditMesh = MoveTemp(SweptMesh);
 		}
-	}
+		else
+		{
+			FMeshIndexMappings TmpMappings;
+			FDynamicMeshEditor Editor(&EditMesh);
+			Editor.AppendMesh(&SweptMesh, TmpMappings);
+		}
+	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown, false);
+	
+	return TargetMesh;
+}
 
+UDynamicMesh* UHandyManModelingUtilities::SweepGeometryAlongSplines(FSweepOptions SweepOptions, const TArray<USplineComponent*>& Splines, const ESplineCoordinateSpace::Type Space, const int32 NumSamplesPerSpline, UGeometryScriptDebug* Debug)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHandyManModelingUtilities::SweepGeometryAlongSplines);
 
+	auto TargetMesh = SweepOptions.TargetMesh;
 	
-	
-	if (SweepPath.Num() < 2)
+	if (TargetMesh == nullptr)
 	{
-		UE::Geometry::AppendError(Debug, EGeometryScriptErrorType::InvalidInputs, LOCTEXT("AppendSweepPolyline_InvalidSweepPath", "AppendSweepPolyline: SweepPath array requires at least 2 positions"));
+		UE::Geometry::AppendError(Debug, EGeometryScriptErrorType::InvalidInputs, LOCTEXT("AppendSweepPolyline_NullMesh", "AppendSweepPolyline: TargetMesh is Null"));
 		return TargetMesh;
 	}
 
-	float RotationInDegrees = SweepOptions.RotationAngleDeg;
-	if (SweepOptions.ShapeType == ESweepShapeType::Box)
+	// Sample the splines on this thread, after this point only plain frame arrays are used
+	TArray<TArray<FTransform>> SweepPaths;
+	SweepPaths.Reserve(Splines.Num());
+	for (USplineComponent* Spline : Splines)
 	{
-		RotationInDegrees = 90;
+		if (!Spline || Spline->GetNumberOfSplinePoints() < 2) continue;
+
+		TArray<FTransform>& SweepPath = SweepPaths.AddDefaulted_GetRef();
+		HandyManSweepFunctions::SampleSweepPath(Spline, SweepOptions, Space, NumSamplesPerSpline, SweepPath);
+
+		if (SweepPath.Num() < 2)
+		{
+			SweepPaths.Pop(EAllowShrinking::No);
+		}
 	}
 
-	if (SweepOptions.ShapeType == ESweepShapeType::Triangle)
+	return SweepGeometryAlongPaths(SweepOptions, SweepPaths, Space, Debug);
+}
+
+UDynamicMesh* UHandyManModelingUtilities::SweepGeometryAlongPaths(FSweepOptions SweepOptions, const TArray<TArray<FTransform>>& SweepPaths, const ESplineCoordinateSpace::Type Space, UGeometryScriptDebug* Debug)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHandyManModelingUtilities::SweepGeometryAlongPaths);
+
+	auto TargetMesh = SweepOptions.TargetMesh;
+	
+	if (TargetMesh == nullptr)
 	{
-		RotationInDegrees = 30;
+		UE::Geometry::AppendError(Debug, EGeometryScriptErrorType::InvalidInputs, LOCTEXT("AppendSweepPolyline_NullMesh", "AppendSweepPolyline: TargetMesh is Null"));
+		return TargetMesh;
 	}
 
-	FMatrix2d Rotation2D = FMatrix2d::RotationDeg(-RotationInDegrees);
-	FGeneralizedCylinderGenerator SweepGen;
-	for (const FVector2D& Point : SweepShapeVertices)
+	if (SweepOptions.bResetTargetMesh)
 	{
-		SweepGen.CrossSection.AppendVertex(Rotation2D * FVector2d(Point.X, Point.Y));
+		TargetMesh->Reset();
 	}
 
-	for (const FTransform& SweepXForm : SweepPath)
+	TArray<FDynamicMesh3> SweptMeshes;
+	if (GenerateSweepMeshes(SweepOptions, SweepPaths, SweptMeshes, Space, Debug))
 	{
-		
-		SweepGen.Path.Add(SweepXForm.GetLocation());
-		FQuaterniond Rotation(SweepXForm.GetRotation());
-		SweepGen.PathFrames.Add(
-			FFrame3d(SweepXForm.GetLocation(), Rotation.AxisY(), Rotation.AxisZ(), Rotation.AxisX())
-		);
-		FVector3d Scale = SweepXForm.GetScale3D();
-		SweepGen.PathScales.Add(FVector2d(Scale.Y, Scale.Z));
+		AppendMeshes(TargetMesh, SweptMeshes);
 	}
+	
+	return TargetMesh;
+}
+
+bool UHandyManModelingUtilities::GenerateSweepMeshes(const FSweepOptions& SweepOptions, const TArray<TArray<FTransform>>& SweepPaths, TArray<FDynamicMesh3>& OutMeshes, const ESplineCoordinateSpace::Type Space, UGeometryScriptDebug* Debug)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(UHandyManModelingUtilities::GenerateSweepMeshes);
 
-	SweepGen.bProfileCurveIsClosed = true;
-	SweepGen.bLoop = false;
-	/*if (PolylineTexParamU.Num() > 0)
+	OutMeshes.Reset();
+	OutMeshes.SetNum(SweepPaths.Num());
+	
+	// Every path shares the same cross section
+	TArray<FVector2D> SweepShapeVertices;
+	HandyManSweepFunctions::BuildCrossSection(SweepOptions, Space, SweepShapeVertices);
+	
+	if (SweepShapeVertices.Num() < 2)
 	{
-		SweepGen.CrossSectionTexCoord = PolylineTexParamU;
+		UE::Geometry::AppendError(Debug, EGeometryScriptErrorType::InvalidInputs, LOCTEXT("AppendSweepPolyline_InvalidPolygon", "AppendSweepPolyline: Polyline array requires at least 2 positions"));
+		return false;
 	}
-	if (SweepPathTexParamV.Num() > 0)
+
+	ParallelFor(SweepPaths.Num(), [&SweepOptions, &SweepShapeVertices, &SweepPaths, &OutMeshes](int32 Index)
 	{
-		SweepGen.PathTexCoord = SweepPathTexParamV;
-	}*/
-	SweepGen.bPolygroupPerQuad = (SweepOptions.PolygroupMode == EGeometryScriptPrimitivePolygroupMode::PerQuad);
-	SweepGen.InitialFrame = FFrame3d(SweepGen.Path[0]);
-	SweepGen.StartScale = SweepOptions.StartEndRadius.X;
-	SweepGen.EndScale = SweepOptions.StartEndRadius.Y;
-	SweepGen.bCapped = SweepOptions.bEndCaps;
+		if (SweepPaths[Index].Num() < 2) return;
+		HandyManSweepFunctions::GenerateSweepMesh(SweepOptions, SweepShapeVertices, SweepPaths[Index], OutMeshes[Index]);
+	});
 
-	
+	return true;
+}
 
+void UHandyManModelingUtilities::AppendMeshes(UDynamicMesh* TargetMesh, const TArray<FDynamicMesh3>& Meshes, const bool bResetTargetMesh)
+{
+	TArray<const FDynamicMesh3*> MeshPtrs;
+	MeshPtrs.Reserve(Meshes.Num());
+	for (const FDynamicMesh3& Mesh : Meshes)
+	{
+		MeshPtrs.Add(&Mesh);
+	}
 	
-	FGeometryScriptPrimitiveOptions PrimitiveOptions;
-	PrimitiveOptions.bFlipOrientation = SweepOptions.bFlipOrientation;
-	PrimitiveOptions.UVMode = SweepOptions.UVMode;
-	PrimitiveOptions.PolygroupMode = SweepOptions.PolygroupMode;
-	
-	SweepGen.Generate();
+	AppendMeshes(TargetMesh, MeshPtrs, bResetTargetMesh);
+}
 
+void UHandyManModelingUtilities::AppendMeshes(UDynamicMesh* TargetMesh, TConstArrayView<const FDynamicMesh3*> Meshes, const bool bResetTargetMesh)
+{
+	if (TargetMesh == nullptr) return;
 	
-
-	GodtierMeshPrimitiveFunctions::AppendPrimitive(TargetMesh, &SweepGen, FTransform::Identity, PrimitiveOptions);
-	return TargetMesh;
+	TargetMesh->EditMesh([&Meshes, bResetTargetMesh](FDynamicMesh3& EditMesh)
+	{
+		if (bResetTargetMesh)
+		{
+			EditMesh.Clear();
+			EditMesh.EnableAttributes();
+		}
+		
+		HandyManSweepFunctions::AppendCompactMeshes(EditMesh, Meshes);
+	}, EDynamicMeshChangeType::GeneralEdit, EDynamicMeshAttributeChangeFlags::Unknown, false);
 }
 
 UDynamicMesh* UHandyManModelingUtilities::GenerateCollisionGeometryAlongSpline(FSimpleCollisionOptions CollisionOptions, const ESplineCoordinateSpace::Type Space, UGeometryScriptDebug* Debug)
@@ -383,39 +611,164 @@ UDynamicMesh* UHandyManModelingUtilities::GenerateMeshFromPlanarFace(UDynamicMes
 	
 }
 
+#pragma region BooleanMeshCache
+namespace HandyManBooleanMeshCache
+{
+	struct FKey
+	{
+		TObjectKey<UStaticMesh> Mesh;
+		EMeshBooleanShape Shape = EMeshBooleanShape::Exact;
+		float Offset = 0.f;
+
+		bool operator==(const FKey& Other) const
+		{
+			return Mesh == Other.Mesh && Shape == Other.Shape && Offset == Other.Offset;
+		}
+
+		friend uint32 GetTypeHash(const FKey& Key)
+		{
+			return HashCombine(HashCombine(GetTypeHash(Key.Mesh), GetTypeHash(Key.Shape)), GetTypeHash(Key.Offset));
+		}
+	};
+
+	static FCriticalSection Lock;
+	static TMap<FKey, TSharedPtr<const FDynamicMesh3>> Entries;
+#if WITH_EDITOR
+	// Rebuild listeners of every cached asset
+	static TMap<TObjectKey<UStaticMesh>, FDelegateHandle> BuildHandles;
+#endif
+
+	static TSharedPtr<const FDynamicMesh3> Find(const FKey& Key)
+	{
+		FScopeLock ScopeLock(&Lock);
+		const TSharedPtr<const FDynamicMesh3>* Found = Entries.Find(Key);
+		return Found ? *Found : nullptr;
+	}
+
+	// Drops every entry built from StaticMesh
+	static void Invalidate(UStaticMesh* StaticMesh)
+	{
+		FScopeLock ScopeLock(&Lock);
+		const TObjectKey<UStaticMesh> MeshKey(StaticMesh);
+		for (auto It = Entries.CreateIterator(); It; ++It)
+		{
+			if (It.Key().Mesh == MeshKey)
+			{
+				It.RemoveCurrent();
+			}
+		}
+#if WITH_EDITOR
+		FDelegateHandle Handle;
+		if (BuildHandles.RemoveAndCopyValue(MeshKey, Handle) && StaticMesh)
+		{
+			StaticMesh->OnPostMeshBuild().Remove(Handle);
+		}
+#endif
+	}
+
+	static void Add(UStaticMesh* StaticMesh, const FKey& Key, TSharedPtr<const FDynamicMesh3> Mesh)
+	{
+		FScopeLock ScopeLock(&Lock);
+#if WITH_EDITOR
+		// Assets only change in the editor, a reimport or a build setting change rebuilds the mesh
+		if (!BuildHandles.Contains(Key.Mesh))
+		{
+			// Forget the meshes that were unloaded since the last time a new asset got cached
+			for (auto It = Entries.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().Mesh.ResolveObjectPtr())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			for (auto It = BuildHandles.CreateIterator(); It; ++It)
+			{
+				if (!It.Key().ResolveObjectPtr())
+				{
+					It.RemoveCurrent();
+				}
+			}
+			BuildHandles.Add(Key.Mesh, StaticMesh->OnPostMeshBuild().AddStatic(&Invalidate));
+		}
+#endif
+		Entries.Add(Key, MoveTemp(Mesh));
+	}
+
+	static void Clear()
+	{
+		FScopeLock ScopeLock(&Lock);
+		Entries.Empty();
+#if WITH_EDITOR
+		for (const auto& Entry : BuildHandles)
+		{
+			if (UStaticMesh* StaticMesh = Entry.Key.ResolveObjectPtr())
+			{
+				StaticMesh->OnPostMeshBuild().Remove(Entry.Value);
+			}
+		}
+		BuildHandles.Empty();
+#endif
+	}
+
+	// Each copy replaces the previous one, so only the last static mesh component ends up in the boolean mesh
+	static UStaticMesh* GetSourceMesh(AActor* TargetActor)
+	{
+		TArray<UStaticMeshComponent*> OutComponents;
+		TargetActor->GetComponents(UStaticMeshComponent::StaticClass(), OutComponents);
+		return OutComponents.Num() > 0 ? OutComponents.Last()->GetStaticMesh() : nullptr;
+	}
+}
+#pragma endregion
+
 UDynamicMesh* UHandyManModelingUtilities::CreateDynamicBooleanMesh(UDynamicMesh* ComputeMesh, AActor* TargetActor, const EMeshBooleanShape BaseShape, const float IntersectionOffset, UGeometryScriptDebug* Debug)
 {
 	if(!ComputeMesh || !TargetActor) return nullptr;
 	ComputeMesh->Reset();
-	
-	if (TargetActor->GetComponentByClass(UStaticMeshComponent::StaticClass()))
+
+	UStaticMesh* StaticMesh = HandyManBooleanMeshCache::GetSourceMesh(TargetActor);
+	if (!StaticMesh)
 	{
-		TArray<UStaticMeshComponent*> OutComponents;
-		TargetActor->GetComponents(UStaticMeshComponent::StaticClass(), OutComponents);
+		return ComputeMesh;
+	}
 
-		FGeometryScriptCopyMeshFromAssetOptions CopyOptions;
-		CopyOptions.bUseBuildScale = false;
-		for (const auto Component : OutComponents)
-		{
-			const FVector NewScale = FVector(1 + IntersectionOffset, 1, 1);
-			
-			EGeometryScriptOutcomePins Outcome;
-			auto CopiedMesh = UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromStaticMeshV2
-			(
-				Component->GetStaticMesh(),
-				ComputeMesh,
-				CopyOptions,
-				FGeometryScriptMeshReadLOD(),
-				Outcome
-			);
+	return CreateDynamicBooleanMeshFromStaticMesh(ComputeMesh, StaticMesh, BaseShape, IntersectionOffset, Debug);
+}
 
-			FTransform Transform( FRotator::ZeroRotator,FVector::Zero(), NewScale);
+UDynamicMesh* UHandyManModelingUtilities::CreateDynamicBooleanMeshFromStaticMesh(UDynamicMesh* ComputeMesh, UStaticMesh* StaticMesh, const EMeshBooleanShape BaseShape, const float IntersectionOffset, UGeometryScriptDebug* Debug)
+{
+	if(!ComputeMesh || !StaticMesh) return nullptr;
 
-			UGeometryScriptLibrary_MeshTransformFunctions::TransformMesh(CopiedMesh, Transform);
-		}
-		
+	const HandyManBooleanMeshCache::FKey Key{ TObjectKey<UStaticMesh>(StaticMesh), BaseShape, IntersectionOffset };
+	if (const TSharedPtr<const FDynamicMesh3> Cached = HandyManBooleanMeshCache::Find(Key))
+	{
+		ComputeMesh->SetMesh(*Cached);
+		return ComputeMesh;
 	}
-	
+
+	ComputeMesh->Reset();
+
+	FGeometryScriptCopyMeshFromAssetOptions CopyOptions;
+	CopyOptions.bUseBuildScale = false;
+
+	EGeometryScriptOutcomePins Outcome;
+	UGeometryScriptLibrary_StaticMeshFunctions::CopyMeshFromStaticMeshV2
+	(
+		StaticMesh,
+		ComputeMesh,
+		CopyOptions,
+		FGeometryScriptMeshReadLOD(),
+		Outcome
+	);
+
+	if (Outcome != EGeometryScriptOutcomePins::Success)
+	{
+		return ComputeMesh;
+	}
+
+	const FVector NewScale = FVector(1 + IntersectionOffset, 1, 1);
+	FTransform Transform( FRotator::ZeroRotator,FVector::Zero(), NewScale);
+
+	UGeometryScriptLibrary_MeshTransformFunctions::TransformMesh(ComputeMesh, Transform);
 
 	if (BaseShape != EMeshBooleanShape::Exact)
 	{
@@ -453,10 +806,37 @@ UDynamicMesh* UHandyManModelingUtilities::CreateDynamicBooleanMesh(UDynamicMesh*
 		TriangulationOptions.SphereStepsPerSide = 24;
 
 		ComputeMesh->Reset();
-		return UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendSimpleCollisionShapes(ComputeMesh, PrimitiveOptions, FTransform::Identity, SimpleCollision, TriangulationOptions);
+		UGeometryScriptLibrary_MeshPrimitiveFunctions::AppendSimpleCollisionShapes(ComputeMesh, PrimitiveOptions, FTransform::Identity, SimpleCollision, TriangulationOptions);
 	}
+
+	HandyManBooleanMeshCache::Add(StaticMesh, Key, MakeShared<const FDynamicMesh3>(ComputeMesh->GetMeshRef()));
 	
 	return ComputeMesh;
 }
 
+void UHandyManModelingUtilities::ClearBooleanMeshCache()
+{
+	HandyManBooleanMeshCache::Clear();
+}
+
+TSharedPtr<const FDynamicMesh3> UHandyManModelingUtilities::GetCachedDynamicBooleanMesh(AActor* TargetActor, const EMeshBooleanShape BooleanShape, const float IntersectionOffset)
+{
+	if (!TargetActor) return nullptr;
+
+	UStaticMesh* StaticMesh = HandyManBooleanMeshCache::GetSourceMesh(TargetActor);
+	if (!StaticMesh) return nullptr;
+
+	const HandyManBooleanMeshCache::FKey Key{ TObjectKey<UStaticMesh>(StaticMesh), BooleanShape, IntersectionOffset };
+	if (TSharedPtr<const FDynamicMesh3> Cached = HandyManBooleanMeshCache::Find(Key))
+	{
+		return Cached;
+	}
+
+	// Builds and caches it
+	UDynamicMesh* ComputeMesh = NewObject<UDynamicMesh>();
+	CreateDynamicBooleanMeshFromStaticMesh(ComputeMesh, StaticMesh, BooleanShape, IntersectionOffset, nullptr);
+
+	return HandyManBooleanMeshCache::Find(Key);
+}
+
 #undef LOCTEXT_NAMESPACE
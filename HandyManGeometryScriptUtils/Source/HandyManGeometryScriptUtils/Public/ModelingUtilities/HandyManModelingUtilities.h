@@ -12,6 +12,7 @@
 #include "HandyManModelingUtilities.generated.h"
 
 class ADynamicMeshActor;
+class UStaticMesh;
 /**
  * 
  */
@@ -23,6 +24,27 @@ class HANDYMANGEOMETRYSCRIPTUTILS_API UHandyManModelingUtilities : public UBluep
 	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Sweep Geometry", Keywords = "Sweep Geometry Pipe Curve"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
 	static UPARAM(DisplayName = "Output Mesh") UDynamicMesh* SweepGeometryAlongSpline(FSweepOptions SweepOptions, const ESplineCoordinateSpace::Type Space = ESplineCoordinateSpace::World, UGeometryScriptDebug* Debug = nullptr);
 
+	/*Sweeps the same shape along every spline into the target mesh.
+	 * Splines are sampled on the calling thread, the meshes are generated in parallel and appended in one pass.
+	 * If NumSamplesPerSpline is above 0 it replaces the sample size for splines that get resampled
+	 */
+	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Sweep Geometry Along Splines", Keywords = "Sweep Geometry Pipe Curve Batch"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
+	static UPARAM(DisplayName = "Output Mesh") UDynamicMesh* SweepGeometryAlongSplines(FSweepOptions SweepOptions, const TArray<USplineComponent*>& Splines, const ESplineCoordinateSpace::Type Space = ESplineCoordinateSpace::World, const int32 NumSamplesPerSpline = 0, UGeometryScriptDebug* Debug = nullptr);
+
+	/*Same as SweepGeometryAlongSplines but from frames that were already sampled, paths with less than 2 frames are skipped.
+	 * Doesn't touch any component so the paths can come from plain data
+	 */
+	static UDynamicMesh* SweepGeometryAlongPaths(FSweepOptions SweepOptions, const TArray<TArray<FTransform>>& SweepPaths, const ESplineCoordinateSpace::Type Space = ESplineCoordinateSpace::World, UGeometryScriptDebug* Debug = nullptr);
+
+	/*Generates one mesh per path in parallel, without appending them anywhere. Paths with less than 2 frames give an empty mesh.
+	 * Returns false if the cross section of the options is invalid
+	 */
+	static bool GenerateSweepMeshes(const FSweepOptions& SweepOptions, const TArray<TArray<FTransform>>& SweepPaths, TArray<UE::Geometry::FDynamicMesh3>& OutMeshes, const ESplineCoordinateSpace::Type Space = ESplineCoordinateSpace::World, UGeometryScriptDebug* Debug = nullptr);
+
+	/*Appends the meshes to the target mesh in a single edit, clearing it first if bResetTargetMesh is set*/
+	static void AppendMeshes(UDynamicMesh* TargetMesh, const TArray<UE::Geometry::FDynamicMesh3>& Meshes, const bool bResetTargetMesh = false);
+	static void AppendMeshes(UDynamicMesh* TargetMesh, TConstArrayView<const UE::Geometry::FDynamicMesh3*> Meshes, const bool bResetTargetMesh = false);
+
 	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Create Planar Mesh From Spline", Keywords = "Sweep Geometry Pipe Curve"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
 	static UPARAM(DisplayName = "Output Mesh") UDynamicMesh* GenerateCollisionGeometryAlongSpline(FSimpleCollisionOptions CollisionOptions, const ESplineCoordinateSpace::Type Space, UGeometryScriptDebug* Debug = nullptr);
 
@@ -34,6 +56,19 @@ class HANDYMANGEOMETRYSCRIPTUTILS_API UHandyManModelingUtilities : public UBluep
 	 */
 	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Create Boolean Mesh From Mesh", Keywords = "Boolean Mesh subtract union intersect"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
 	static UPARAM(DisplayName = "Output Mesh") UDynamicMesh* CreateDynamicBooleanMesh(UDynamicMesh* ComputeMesh, AActor* TargetActor, const EMeshBooleanShape BooleanShape, const float IntersectionOffset = 0.5f, UGeometryScriptDebug* Debug = nullptr);
+
+	/*Same as CreateDynamicBooleanMesh but from a static mesh asset.
+	 * Results are cached per (mesh, shape, offset) and reused until the asset is rebuilt
+	 */
+	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Create Boolean Mesh From Static Mesh", Keywords = "Boolean Mesh subtract union intersect"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
+	static UPARAM(DisplayName = "Output Mesh") UDynamicMesh* CreateDynamicBooleanMeshFromStaticMesh(UDynamicMesh* ComputeMesh, UStaticMesh* StaticMesh, const EMeshBooleanShape BooleanShape, const float IntersectionOffset = 0.5f, UGeometryScriptDebug* Debug = nullptr);
+
+	/*Drops every cached boolean mesh, they will be rebuilt on the next request*/
+	UFUNCTION(BlueprintCallable, meta = (ScriptMethod, DisplayName = "Clear Boolean Mesh Cache"), Category = "HandyManGeometryScriptUtils | Modeling Utilities")
+	static void ClearBooleanMeshCache();
+
+	/*Returns the cached boolean mesh of the actor, building it on a miss. The result is shared, copy it before editing*/
+	static TSharedPtr<const UE::Geometry::FDynamicMesh3> GetCachedDynamicBooleanMesh(AActor* TargetActor, const EMeshBooleanShape BooleanShape, const float IntersectionOffset = 0.5f);
 	
 
 	